@@ -29,6 +29,7 @@
 #include "client.h"
 #include "compositor.h"
 #include "config.h"
+#include "cpu/window.h"
 #include "detail/fileFrameWriter.h"
 #include "error.h"
 #include "frame.h"
@@ -60,6 +61,7 @@
 #include <co/connectionDescription.h>
 #include <co/exception.h>
 #include <co/objectICommand.h>
+#include <co/objectOCommand.h>
 #include <co/queueSlave.h>
 #include <co/sendToken.h>
 #include <lunchbox/rng.h>
@@ -71,6 +73,7 @@
 #  include <GLStats/GLStats.h>
 #endif
 
+#include <algorithm>
 #include <bitset>
 #include <set>
 
@@ -91,6 +94,28 @@ using detail::STATE_RUNNING;
 using detail::STATE_FAILED;
 /** @endcond */
 
+namespace
+{
+/** @return the in-memory system window of the channel, or 0. */
+cpu::Window* _getCPUWindow( Window* window )
+{
+    return dynamic_cast< cpu::Window* >( window->getSystemWindow( ));
+}
+
+/**
+ * Compute the coverage of a DB image once before it is published, since the
+ * transmission to each receiver and the local assembly read it concurrently.
+ */
+void _updateCoverage( Image* image )
+{
+    if( image->hasPixelData( Frame::Buffer::color ) &&
+        image->hasPixelData( Frame::Buffer::depth ))
+    {
+        image->updateCoverage();
+    }
+}
+}
+
 Channel::Channel( Window* parent )
         : Super( parent )
         , _impl( new detail::Channel )
@@ -343,6 +368,23 @@ void Channel::frameDraw( const uint128_t& )
 
 void Channel::frameAssemble( const uint128_t&, const Frames& frames )
 {
+    cpu::Window* cpuWindow = _getCPUWindow( getWindow( ));
+    if( cpuWindow )
+    {
+        const PixelViewport& pvp = getPixelViewport();
+        try
+        {
+            const Image* image = Compositor::mergeFramesCPU( frames, true );
+            if( image )
+                cpuWindow->assemble( *image, Vector2i( pvp.x, pvp.y ), true );
+        }
+        catch( const co::Exception& e )
+        {
+            LBWARN << e.what() << std::endl;
+        }
+        return;
+    }
+
     EQ_GL_CALL( applyBuffer( ));
     EQ_GL_CALL( applyViewport( ));
     EQ_GL_CALL( setupAssemblyState( ));
@@ -363,6 +405,15 @@ void Channel::frameReadback( const uint128_t&, const Frames& frames )
     if( !region.hasArea( ))
         return;
 
+    cpu::Window* cpuWindow = _getCPUWindow( getWindow( ));
+    if( cpuWindow )
+    {
+        for( Frame* frame : frames )
+            cpuWindow->readback( *frame, region, getDrawableConfig(),
+                                 getContext( ));
+        return;
+    }
+
     EQ_GL_CALL( applyBuffer( ));
     EQ_GL_CALL( applyViewport( ));
     EQ_GL_CALL( setupAssemblyState( ));
@@ -898,7 +949,7 @@ bool Channel::processEvent( Statistic& event )
 {
     Config* config = getConfig();
     updateEvent( event, config->getTime( ));
-    config->sendEvent( EVENT_STATISTIC ) << event;
+    config->sendStatistic( event );
     return true;
 }
 
@@ -1144,8 +1195,10 @@ void Channel::_unrefFrame( const uint32_t frameNumber )
     if( --stats.used != 0 ) // Frame still in use
         return;
 
-    send( getServer(), fabric::CMD_CHANNEL_FRAME_FINISH_REPLY )
-            << stats.region << frameNumber << stats.data;
+    co::ObjectOCommand command = send( getServer(),
+                                       fabric::CMD_CHANNEL_FRAME_FINISH_REPLY );
+    command << stats.region << frameNumber;
+    fabric::serializeStatistics( command, stats.data );
 
     stats.data.clear();
     stats.region = Viewport::FULL;
@@ -1229,8 +1282,11 @@ bool Channel::_asyncFinishReadback( const std::vector< size_t >& imagePos,
                         << getTaskID() << nodes << netNodes;
             }
             else // transmit images asynchronously
+            {
+                _updateCoverage( images[j] );
                 _asyncTransmit( frameData, frameNumber, j, nodes, netNodes,
                                 getTaskID( ));
+            }
         }
     }
     return hasAsyncReadback;
@@ -1262,6 +1318,7 @@ void Channel::_finishReadback( const co::ObjectVersion& frameDataVersion,
     const GLEWContext* glewContext = window->getTransferGlewContext();
     image->finishReadback( glewContext );
     LBASSERT( !image->hasAsyncReadback( ));
+    _updateCoverage( image );
 
     // schedule async image tranmission
     _asyncTransmit( frameData, frameNumber, imageIndex, nodes, netNodes,
@@ -1290,6 +1347,32 @@ void Channel::_asyncTransmit( FrameDataPtr frame, const uint32_t frameNumber,
     }
 }
 
+void Channel::_updateTransmitQuality( const FrameData& frameData,
+                                      const Image& image,
+                                      const uint32_t frameNumber )
+{
+    if( frameNumber == _impl->transmitFrame )
+        return;
+
+    // The transmission is the bottleneck if it was busy during most of the
+    // last frame, it has time left if it was idle during half of it.
+    const int64_t time = getConfig()->getTime();
+    const int64_t interval = time - _impl->transmitStart;
+
+    // The head transform is the same for all tiles and subpixels of a frame
+    const RenderContext& context = image.getContext();
+    const RenderContext& last = _impl->transmitContext;
+    const bool moving = frameData.isMoving() ||
+                        ( context.eye == last.eye &&
+                          context.headTransform != last.headTransform );
+
+    _impl->transmitQuality.update( moving, _impl->transmitTime, interval );
+    _impl->transmitFrame = frameNumber;
+    _impl->transmitStart = time;
+    _impl->transmitTime = 0;
+    _impl->transmitContext = context;
+}
+
 void Channel::_transmitImage( const co::ObjectVersion& frameDataVersion,
                               const uint128_t& nodeID,
                               const co::NodeID& netNodeID,
@@ -1340,8 +1423,27 @@ void Channel::_transmitImage( const co::ObjectVersion& frameDataVersion,
     std::vector< const PixelData* > pixelDatas;
     std::vector< float > qualities;
 
+    const int64_t startTime = getConfig()->getTime();
+    _updateTransmitQuality( *frameData, *image, frameNumber );
+
+    // Send only the pixels not on the far plane of mostly empty DB images. The
+    // coverage was computed after the readback, see _updateCoverage().
+    const bool packed = image->hasPixelData( Frame::Buffer::color ) &&
+                        image->hasPixelData( Frame::Buffer::depth ) &&
+                        image->getCoverageRatio() < .75f &&
+                        image->packPixelData( Frame::Buffer::depth,
+                                              _impl->packedImage );
+    Image& source = packed ? _impl->packedImage : *image;
+    if( packed )
+    {
+        source.setAlphaUsage( image->getAlphaUsage( ));
+        LBCHECK( image->packPixelData( Frame::Buffer::color, source ));
+    }
+    const Image::CoverageMask& mask = image->getCoverage();
+
     Frame::Buffer commandBuffers = Frame::Buffer::none;
-    uint64_t imageDataSize = 0;
+    uint64_t imageDataSize = packed ?
+        sizeof( uint64_t ) + mask.size() * sizeof( uint64_t ) : 0;
     {
         uint64_t rawSize( 0 );
         ChannelStatistics compressEvent( Statistic::CHANNEL_FRAME_COMPRESS,
@@ -1351,6 +1453,7 @@ void Channel::_transmitImage( const co::ObjectVersion& frameDataVersion,
         compressEvent.statistic.ratio = 1.0f;
         compressEvent.statistic.plugins[0] = EQ_COMPRESSOR_NONE;
         compressEvent.statistic.plugins[1] = EQ_COMPRESSOR_NONE;
+        compressEvent.statistic.quality = 1.0f;
 
         // Prepare image pixel data
         Frame::Buffer buffers[] = {Frame::Buffer::color,Frame::Buffer::depth};
@@ -1364,11 +1467,20 @@ void Channel::_transmitImage( const co::ObjectVersion& frameDataVersion,
                 // format, type, nChunks, compressor name
                 imageDataSize += sizeof( FrameData::ImageHeader );
 
+                // lower the quality down to the adaptive minimum quality
+                const float minQuality =
+                    frameData->getAdaptiveQuality( buffer );
+                const float quality = _impl->transmitQuality.getQuality(
+                    image->getQuality( buffer ), minQuality );
+                source.setQuality( buffer, quality );
+                if( buffer == Frame::Buffer::color )
+                    compressEvent.statistic.quality = quality;
+
                 const PixelData& data = useCompression ?
-                    image->compressPixelData( buffer ) :
-                    image->getPixelData( buffer );
+                    source.compressPixelData( buffer ) :
+                    source.getPixelData( buffer );
                 pixelDatas.push_back( &data );
-                qualities.push_back( image->getQuality( buffer ));
+                qualities.push_back( quality );
 
                 if( data.compressedData.isCompressed( ))
                 {
@@ -1379,7 +1491,7 @@ void Channel::_transmitImage( const co::ObjectVersion& frameDataVersion,
                 }
                 else
                     imageDataSize += sizeof( uint64_t ) +
-                                     image->getPixelDataSize( buffer );
+                                     source.getPixelDataSize( buffer );
 
                 commandBuffers |= buffer;
                 rawSize += image->getPixelDataSize( buffer );
@@ -1389,6 +1501,7 @@ void Channel::_transmitImage( const co::ObjectVersion& frameDataVersion,
         if( rawSize > 0 )
             compressEvent.statistic.ratio =
                 float( imageDataSize ) / float( rawSize );
+        compressEvent.statistic.bytes = imageDataSize;
     }
 
     if( pixelDatas.empty( ))
@@ -1411,13 +1524,23 @@ void Channel::_transmitImage( const co::ObjectVersion& frameDataVersion,
                                 CO_INSTANCE_ALL );
     command << frameDataVersion << image->getPixelViewport() << image->getZoom()
             << image->getContext() << commandBuffers << frameNumber
-            << image->getAlphaUsage();
+            << image->getAlphaUsage() << packed;
     command.sendHeader( imageDataSize );
 
 #ifndef NDEBUG
     size_t sentBytes = 0;
 #endif
 
+    if( packed )
+    {
+        const uint64_t nWords = mask.size();
+        connection->send( &nWords, sizeof( nWords ), true );
+        connection->send( mask.data(), nWords * sizeof( uint64_t ), true );
+#ifndef NDEBUG
+        sentBytes += sizeof( nWords ) + nWords * sizeof( uint64_t );
+#endif
+    }
+
     for( uint32_t j=0; j < pixelDatas.size(); ++j )
     {
 #ifndef NDEBUG
@@ -1465,6 +1588,7 @@ void Channel::_transmitImage( const co::ObjectVersion& frameDataVersion,
     LBASSERTINFO( sentBytes == imageDataSize,
         sentBytes << " != " << imageDataSize );
 #endif
+    _impl->transmitTime += getConfig()->getTime() - startTime;
 }
 
 void Channel::_setReady( const bool async, detail::RBStat* stat,
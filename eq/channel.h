@@ -530,7 +530,8 @@ protected:
     /**
      * Assemble all input frames.
      *
-     * Called 0 to n times during one frame.
+     * Called 0 to n times during one frame. On a cpu::Window, the frames are
+     * merged in main memory and assembled into the window buffers.
      *
      * @param frameID the per-frame identifier.
      * @param frames the input frames.
@@ -542,7 +543,8 @@ protected:
     /**
      * Read back the rendered frame buffer into the output frames.
      *
-     * Called 0 to n times during one frame.
+     * Called 0 to n times during one frame. On a cpu::Window, the window
+     * buffers are read into memory images.
      *
      * @param frameID the per-frame identifier.
      * @param frames the output frames.
@@ -646,6 +648,11 @@ private:
                          const uint32_t frameNumber,
                          const uint32_t taskID );
 
+    /** Update the adaptive transmission quality once per frame. */
+    void _updateTransmitQuality( const FrameData& frameData,
+                                 const Image& image,
+                                 const uint32_t frameNumber );
+
     void _frameReadback( const uint128_t& frameID,
                          const co::ObjectVersions& frames );
     void _finishReadback( const co::ObjectVersion& frameDataVersion,
@@ -23,10 +23,12 @@
 #include "channelStatistics.h"
 #include "client.h"
 #include "compositor.h"
+#include "detail/orderedBlender.h"
 #include "config.h"
 #include "exception.h"
 #include "frameData.h"
 #include "gl.h"
+#include "half.h"
 #include "image.h"
 #include "imageOp.h"
 #include "log.h"
@@ -45,6 +47,9 @@
 #include <lunchbox/os.h>
 #include <pression/plugins/compressor.h>
 
+#include <algorithm>
+#include <limits>
+
 using lunchbox::Monitor;
 
 namespace eq
@@ -63,6 +68,22 @@ static const char* depthDBKey  = shaderDBKey + 2;
 // Image used for CPU-based assembly
 static lunchbox::PerThread< Image > _resultImage;
 
+// Buffers and images used for sparse CPU-based assembly
+struct SparseResult
+{
+    ~SparseResult()
+    {
+        for( Image* image : images )
+            delete image;
+    }
+
+    std::vector< uint8_t > color;
+    std::vector< uint32_t > depth;
+    std::vector< uint8_t > rows;  //!< gathered region rows
+    Images images;               //!< allocated region images
+};
+static lunchbox::PerThread< SparseResult > _sparseResult;
+
 struct CPUAssemblyFormat
 {
     CPUAssemblyFormat( const bool blend_ )
@@ -101,15 +122,14 @@ bool _useCPUAssembly( const Image* image, CPUAssemblyFormat& format )
 
     switch( format.colorExt )
     {
-    case EQ_COMPRESSOR_DATATYPE_RGB10_A2:
-    case EQ_COMPRESSOR_DATATYPE_BGR10_A2:
-        if( !hasDepth )
-            // blending of RGB10A2 not implemented
-            return false;
-        break;
-
     case EQ_COMPRESSOR_DATATYPE_RGBA:
     case EQ_COMPRESSOR_DATATYPE_BGRA:
+    case EQ_COMPRESSOR_DATATYPE_RGB10_A2:
+    case EQ_COMPRESSOR_DATATYPE_BGR10_A2:
+    case EQ_COMPRESSOR_DATATYPE_RGBA16F:
+    case EQ_COMPRESSOR_DATATYPE_BGRA16F:
+    case EQ_COMPRESSOR_DATATYPE_RGBA32F:
+    case EQ_COMPRESSOR_DATATYPE_BGRA32F:
         break;
 
     default:
@@ -133,57 +153,64 @@ bool _useCPUAssembly( const Image* image, CPUAssemblyFormat& format )
     return format.depthExt == EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT;
 }
 
-bool _useCPUAssembly( const Frames& frames, Channel* channel,
-                      const bool blend = false )
+bool _useCPUAssembly( const Frames& frames )
 {
     // It doesn't make sense to use CPU-assembly for only one frame
     if( frames.size() < 2 )
         return false;
 
-    // Test that the input frames have color and depth buffers or that
-    // alpha-blended assembly is used with multiple RGBA buffers. We assume then
-    // that we will have at least one image per frame so most likely it's worth
-    // to wait for the images and to do a CPU-based assembly. Also test early
-    // for unsupported decomposition modes
-    const Frame::Buffer desiredBuffers = blend ? Frame::Buffer::color :
-                                    Frame::Buffer::color | Frame::Buffer::depth;
+    // Test that the input frames have color and depth buffers, and test early
+    // for unsupported decomposition modes. The images are tested as they
+    // arrive, see Compositor::assembleFramesUnsortedCPU. 2D tiles are not
+    // merged: the result is drawn over the union of all tiles without a depth
+    // test, which would clear the uncovered parts rendered by the destination.
+    // They are assembled directly as they arrive by assembleFramesUnsorted.
     for( const Frame* frame : frames )
     {
         const RenderContext& context = frame->getFrameData()->getContext();
 
-        if( frame->getBuffers() != desiredBuffers ||
-            context.pixel != Pixel::ALL || context.subPixel != SubPixel::ALL ||
+        if( frame->getBuffers() !=
+                ( Frame::Buffer::color | Frame::Buffer::depth ) ||
+            context.subPixel != SubPixel::ALL ||
             frame->getFrameData()->getZoom() != Zoom::NONE ||
             frame->getZoom() != Zoom::NONE ) // Not supported by CPU compositor
         {
             return false;
         }
     }
+    return true;
+}
 
-    // Wait for all images to be ready and test if our assumption was correct,
-    // that there are enough images to make a CPU-based assembly worthwhile and
-    // all other preconditions for our CPU-based assembly code are true.
-    size_t nImages = 0;
-    const uint32_t timeout = channel->getConfig()->getTimeout();
-    CPUAssemblyFormat format( blend );
-
+bool _useOrderedCPUBlending( const Frames& frames )
+{
     for( const Frame* frame : frames )
     {
-        {
-            ChannelStatistics event( Statistic::CHANNEL_FRAME_WAIT_READY,
-                                     channel );
-            frame->waitReady( timeout );
-        }
+        const RenderContext& context = frame->getFrameData()->getContext();
 
-        const Images& images = frame->getImages();
-        for( const Image* image : images )
+        if( context.pixel != Pixel::ALL || context.subPixel != SubPixel::ALL ||
+            frame->getFrameData()->getZoom() != Zoom::NONE ||
+            frame->getZoom() != Zoom::NONE ) // Not supported by CPU compositor
         {
-            if( !_useCPUAssembly( image, format ))
-                return false;
-            ++nImages;
+            return false;
         }
     }
-    return (nImages > 1);
+    return true;
+}
+
+bool _useOrderedCPUBlending( const Image* image, CPUAssemblyFormat& format )
+{
+    return image->getStorageType() == Frame::TYPE_MEMORY &&
+           !image->hasPixelData( Frame::Buffer::depth ) &&
+           _useCPUAssembly( image, format ) &&
+           ( format.colorExt == EQ_COMPRESSOR_DATATYPE_RGBA ||
+             format.colorExt == EQ_COMPRESSOR_DATATYPE_BGRA );
+}
+
+void _removeListener( const Frames& frames,
+                      lunchbox::Monitor< uint32_t >& monitor )
+{
+    for( Frame* frame : frames )
+        frame->removeListener( monitor );
 }
 
 bool _useCPUAssembly( const ImageOps& ops, const bool blend )
@@ -239,11 +266,13 @@ bool _collectOutputData( const ImageOps& ops, PixelViewport& destPVP,
                          uint32_t& colorExt, uint32_t& depthInt,
                          uint32_t& depthPixelSize, uint32_t& depthExt )
 {
+    // one subpixel step at a time, see Compositor::extractOneSubPixel
+    if( Compositor::isSubPixelDecomposition( ops ))
+        return false;
+
     for( const ImageOp& op : ops )
     {
-        const RenderContext& context = op.image->getContext();
-        if( context.pixel != Pixel::ALL || context.subPixel != SubPixel::ALL ||
-            op.zoom != Zoom::NONE ||
+        if( op.zoom != Zoom::NONE ||
             op.image->getStorageType() != Frame::TYPE_MEMORY )
         {
             return false;
@@ -252,7 +281,7 @@ bool _collectOutputData( const ImageOps& ops, PixelViewport& destPVP,
         if( !op.image->hasPixelData( Frame::Buffer::color ))
             continue;
 
-        destPVP.merge( op.image->getPixelViewport() + op.offset );
+        destPVP.merge( _getDestPVP( op.image, op.offset ));
 
         _collectOutputData( op.image->getPixelData( Frame::Buffer::color ),
                             colorInt, colorPixelSize, colorExt );
@@ -269,52 +298,157 @@ bool _collectOutputData( const ImageOps& ops, PixelViewport& destPVP,
     return destPVP.hasArea();
 }
 
-void _mergeDBImage( void* destColor, void* destDepth,
-                    const PixelViewport& destPVP, const Image* image,
-                    const Vector2i& offset )
+Image* _newResultImage( const PixelViewport& destPVP, const uint32_t colorInt,
+                        const uint32_t colorPixelSize, const uint32_t colorExt,
+                        const uint32_t depthInt, const uint32_t depthPixelSize,
+                        const uint32_t depthExt )
 {
-    LBASSERT( destColor && destDepth );
+    // prepare output image
+    if( !_resultImage )
+        _resultImage = new Image;
+    Image* result = _resultImage.get();
 
-    LBVERB << "CPU-DB assembly" << std::endl;
+    // pre-condition check for current _merge implementations
+    LBASSERT( colorInt != 0 );
 
-    uint32_t* destC = reinterpret_cast< uint32_t* >( destColor );
-    uint32_t* destD = reinterpret_cast< uint32_t* >( destDepth );
+    result->setPixelViewport( destPVP );
 
-    const PixelViewport&  pvp    = image->getPixelViewport();
+    PixelData colorPixels;
+    colorPixels.internalFormat = colorInt;
+    colorPixels.externalFormat = colorExt;
+    colorPixels.pixelSize      = colorPixelSize;
+    colorPixels.pvp            = destPVP;
+    result->setPixelData( Frame::Buffer::color, colorPixels );
+
+    if( depthInt != 0 ) // at least one depth assembly
+    {
+        LBASSERT( depthExt ==
+                  EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT );
+        PixelData depthPixels;
+        depthPixels.internalFormat = depthInt;
+        depthPixels.externalFormat = depthExt;
+        depthPixels.pixelSize      = depthPixelSize;
+        depthPixels.pvp            = destPVP;
+        result->setPixelData( Frame::Buffer::depth, depthPixels );
+    }
+    return result;
+}
+
+/**
+ * @return the destination area of an image. Pixel-decomposed images are
+ *         scattered with a stride of the pixel decomposition size.
+ */
+PixelViewport _getDestPVP( const Image* image, const Vector2i& offset )
+{
+    const Pixel& pixel = image->getContext().pixel;
+    const PixelViewport& pvp = image->getPixelViewport();
+    return PixelViewport( offset.x() + pvp.x * pixel.w,
+                          offset.y() + pvp.y * pixel.h,
+                          pvp.w * pixel.w, pvp.h * pixel.h );
+}
 
-    const int32_t         destX  = offset.x() + pvp.x - destPVP.x;
-    const int32_t         destY  = offset.y() + pvp.y - destPVP.y;
+/** @return the position of the first image pixel in the destination. */
+Vector2i _getDestPosition( const Image* image, const PixelViewport& destPVP,
+                           const Vector2i& offset )
+{
+    const Pixel& pixel = image->getContext().pixel;
+    const PixelViewport pvp = _getDestPVP( image, offset );
+    return Vector2i( pvp.x + pixel.x - destPVP.x, pvp.y + pixel.y - destPVP.y );
+}
 
-    const uint32_t* color = reinterpret_cast< const uint32_t* >
+/** The color of one 128 bit RGBA32F pixel, copied as a whole. */
+struct Color128
+{
+    uint64_t value[2];
+};
+
+template< class C >
+void _mergeDB( C* destColor, uint32_t* destDepth, const PixelViewport& destPVP,
+               const Image* image, const Vector2i& offset )
+{
+    const PixelViewport&  pvp    = image->getPixelViewport();
+    const Pixel&          pixel  = image->getContext().pixel;
+    const Vector2i        dest   = _getDestPosition( image, destPVP, offset );
+
+    const C* color = reinterpret_cast< const C* >
         ( image->getPixelPointer( Frame::Buffer::color ));
     const uint32_t* depth = reinterpret_cast< const uint32_t* >
         ( image->getPixelPointer( Frame::Buffer::depth ));
 
+    // Uncovered segments are on the far plane and never pass the depth test
+    const Image::CoverageMask& coverage = image->getCoverage();
+    const int32_t segment = coverage.empty() ? pvp.w :
+                                               Image::COVERAGE_SEGMENT;
+    const int32_t nSegments = coverage.empty() ? 1 :
+                                           ( pvp.w + segment - 1 ) / segment;
+
 #pragma omp parallel for
     for( int32_t y = 0; y < pvp.h; ++y )
     {
-        const uint32_t skip =  (destY + y) * destPVP.w + destX;
-        uint32_t* destColorIt = destC + skip;
-        uint32_t* destDepthIt = destD + skip;
-        const uint32_t* colorIt = color + y * pvp.w;
-        const uint32_t* depthIt = depth + y * pvp.w;
+        const uint32_t skip = ( dest.y() + y * pixel.h ) * destPVP.w +
+                              dest.x();
 
-        for( int32_t x = 0; x < pvp.w; ++x )
+        for( int32_t i = 0; i < nSegments; ++i )
         {
-            if( *destDepthIt > *depthIt )
+            if( !coverage.empty() &&
+                !Image::isCovered( coverage, size_t( y ) * nSegments + i ))
             {
-                *destColorIt = *colorIt;
-                *destDepthIt = *depthIt;
+                continue;
             }
 
-            ++destColorIt;
-            ++destDepthIt;
-            ++colorIt;
-            ++depthIt;
+            const int32_t start = i * segment;
+            const int32_t end = std::min( start + segment, pvp.w );
+            C* destColorIt = destColor + skip + start * pixel.w;
+            uint32_t* destDepthIt = destDepth + skip + start * pixel.w;
+            const C* colorIt = color + y * pvp.w + start;
+            const uint32_t* depthIt = depth + y * pvp.w + start;
+
+            for( int32_t x = start; x < end; ++x )
+            {
+                if( *destDepthIt > *depthIt )
+                {
+                    *destColorIt = *colorIt;
+                    *destDepthIt = *depthIt;
+                }
+
+                destColorIt += pixel.w;
+                destDepthIt += pixel.w;
+                ++colorIt;
+                ++depthIt;
+            }
         }
     }
 }
 
+void _mergeDBImage( void* destColor, void* destDepth,
+                    const PixelViewport& destPVP, const Image* image,
+                    const Vector2i& offset )
+{
+    LBASSERT( destColor && destDepth );
+
+    LBVERB << "CPU-DB assembly" << std::endl;
+
+    uint32_t* destD = reinterpret_cast< uint32_t* >( destDepth );
+
+    switch( image->getPixelSize( Frame::Buffer::color ))
+    {
+    case 4: // RGBA, RGB10_A2
+        _mergeDB( reinterpret_cast< uint32_t* >( destColor ), destD, destPVP,
+                  image, offset );
+        break;
+    case 8: // RGBA16F
+        _mergeDB( reinterpret_cast< uint64_t* >( destColor ), destD, destPVP,
+                  image, offset );
+        break;
+    case 16: // RGBA32F
+        _mergeDB( reinterpret_cast< Color128* >( destColor ), destD, destPVP,
+                  image, offset );
+        break;
+    default:
+        LBUNIMPLEMENTED;
+    }
+}
+
 void _merge2DImage( void* destColor, void* destDepth,
                     const eq::PixelViewport& destPVP, const Image* image,
                     const Vector2i& offset )
@@ -323,11 +457,11 @@ void _merge2DImage( void* destColor, void* destDepth,
     LBVERB << "CPU-2D assembly" << std::endl;
 
     uint8_t* destC = reinterpret_cast< uint8_t* >( destColor );
-    uint8_t* destD = reinterpret_cast< uint8_t* >( destDepth );
+    uint32_t* destD = reinterpret_cast< uint32_t* >( destDepth );
 
     const PixelViewport&  pvp    = image->getPixelViewport();
-    const int32_t         destX  = offset.x() + pvp.x - destPVP.x;
-    const int32_t         destY  = offset.y() + pvp.y - destPVP.y;
+    const Pixel&          pixel  = image->getContext().pixel;
+    const Vector2i        dest   = _getDestPosition( image, destPVP, offset );
 
     LBASSERT( image->hasPixelData( Frame::Buffer::color ));
 
@@ -338,11 +472,195 @@ void _merge2DImage( void* destColor, void* destDepth,
 #pragma omp parallel for
     for( int32_t y = 0; y < pvp.h; ++y )
     {
-        const size_t skip = ( (destY + y) * destPVP.w + destX ) * pixelSize;
-        memcpy( destC + skip, color + y * pvp.w * pixelSize, rowLength);
-        // clear depth, for depth-assembly into existing FB
-        if( destD )
-            lunchbox::setZero( destD + skip, rowLength );
+        const size_t skip = ( dest.y() + y * pixel.h ) * destPVP.w + dest.x();
+        const uint8_t* src = color + y * pvp.w * pixelSize;
+
+        if( pixel.w == 1 )
+        {
+            memcpy( destC + skip * pixelSize, src, rowLength );
+            // clear depth, for depth-assembly into existing FB
+            if( destD )
+                lunchbox::setZero( destD + skip, pvp.w * sizeof( uint32_t ));
+            continue;
+        }
+
+        // scatter the pixels of a pixel decomposition
+        for( int32_t x = 0; x < pvp.w; ++x )
+        {
+            const size_t i = skip + x * pixel.w;
+            memcpy( destC + i * pixelSize, src + x * pixelSize, pixelSize );
+            if( destD )
+                destD[i] = 0;
+        }
+    }
+}
+
+// Blending of two slices, none of which is on final image (i.e. result
+// could be blended on to something else) should be performed with:
+// glBlendFuncSeparate( GL_ONE, GL_SRC_ALPHA, GL_ZERO, GL_SRC_ALPHA )
+// which means:
+// dstColor = 1*srcColor + srcAlpha*dstColor
+// dstAlpha = 0*srcAlpha + srcAlpha*dstAlpha
+// because we accumulate light which is go through (= 1-Alpha) and we
+// already have colors as Alpha*Color
+
+void _blendRGBA( const uint8_t* src, uint8_t* dst, const int32_t n )
+{
+    for( int32_t x = 0; x < n; ++x )
+    {
+        dst[0] = LB_MIN( src[0] + (src[3]*dst[0] >> 8), 255 );
+        dst[1] = LB_MIN( src[1] + (src[3]*dst[1] >> 8), 255 );
+        dst[2] = LB_MIN( src[2] + (src[3]*dst[2] >> 8), 255 );
+        dst[3] =                   src[3]*dst[3] >> 8;
+
+        src += 4;
+        dst += 4;
+    }
+}
+
+// GL_UNSIGNED_INT_10_10_10_2: three 10 bit colors, two bit alpha in the LSBs
+void _blendRGB10A2( const uint32_t* src, uint32_t* dst, const int32_t n )
+{
+    for( int32_t x = 0; x < n; ++x )
+    {
+        const uint32_t alpha = src[x] & 0x3u;
+        uint32_t value = ( alpha * ( dst[x] & 0x3u )) / 3;
+
+        for( uint32_t shift = 2; shift < 32; shift += 10 )
+        {
+            const uint32_t s = ( src[x] >> shift ) & 0x3ffu;
+            const uint32_t d = ( dst[x] >> shift ) & 0x3ffu;
+            value |= LB_MIN( s + alpha * d / 3, 0x3ffu ) << shift;
+        }
+        dst[x] = value;
+    }
+}
+
+void _blendRGBA32F( const float* src, float* dst, const int32_t n )
+{
+    for( int32_t i = 0; i < n * 4; i += 4 )
+    {
+        const float alpha = src[i+3];
+        dst[i]   = src[i]   + alpha * dst[i];
+        dst[i+1] = src[i+1] + alpha * dst[i+1];
+        dst[i+2] = src[i+2] + alpha * dst[i+2];
+        dst[i+3] =            alpha * dst[i+3];
+    }
+}
+
+/** Float values of all half floats. */
+struct HalfToFloat
+{
+    HalfToFloat()
+    {
+        for( size_t i = 0; i <= std::numeric_limits< uint16_t >::max(); ++i )
+            values[i] = half_to_float( uint16_t( i ));
+    }
+
+    float values[ std::numeric_limits< uint16_t >::max() + 1 ];
+};
+
+const float* _getHalfToFloat()
+{
+    static const HalfToFloat halfToFloat;
+    return halfToFloat.values;
+}
+
+/**
+ * Convert n floats to half floats, rounding to nearest even. Unlike
+ * half_from_float(), all cases are computed and selected without branches, so
+ * the compiler can vectorize it. Values too large for a half float become
+ * infinity.
+ */
+void _floatToHalf( const float* src, uint16_t* dst, const int32_t n )
+{
+    const uint32_t infinity = 255u << 23;
+    const uint32_t halfMax = ( 127u + 16u ) << 23; // first value rounding to inf
+    const uint32_t halfMin = 113u << 23; // smallest normal half float
+    const uint32_t denormMagic = (( 127u - 15u ) + ( 23u - 10u ) + 1u ) << 23;
+    float denormMagicF;
+    memcpy( &denormMagicF, &denormMagic, sizeof( float ));
+
+    for( int32_t i = 0; i < n; ++i )
+    {
+        uint32_t value;
+        memcpy( &value, src + i, sizeof( float ));
+        const uint32_t sign = value & 0x80000000u;
+        value ^= sign;
+
+        // denormal: align the mantissa by adding a magic value in float
+        float denormF;
+        memcpy( &denormF, &value, sizeof( float ));
+        denormF += denormMagicF;
+        uint32_t denorm;
+        memcpy( &denorm, &denormF, sizeof( float ));
+        denorm -= denormMagic;
+
+        // normal: rebias the exponent and round the mantissa
+        const uint32_t normal = ( value - ( 112u << 23 ) + 0xfffu +
+                                  (( value >> 13 ) & 1u )) >> 13;
+
+        // select with masks, the compiler does not vectorize conditionals
+        const uint32_t isDenorm = 0u - uint32_t( value < halfMin );
+        const uint32_t isInfNaN = 0u - uint32_t( value >= halfMax );
+        const uint32_t infNaN = 0x7c00u | ( uint32_t( value > infinity ) << 9 );
+        uint32_t half = ( denorm & isDenorm ) | ( normal & ~isDenorm );
+        half = ( infNaN & isInfNaN ) | ( half & ~isInfNaN );
+        dst[i] = uint16_t( half | ( sign >> 16 ));
+    }
+}
+
+void _blendRGBA16F( const uint16_t* src, uint16_t* dst, const int32_t n )
+{
+    // Blend in float in chunks of pixels: convert with the table, blend, and
+    // convert back with the vectorizable _floatToHalf().
+    static const int32_t chunkSize = 256;
+    const float* table = _getHalfToFloat();
+    float front[ chunkSize * 4 ];
+    float back[ chunkSize * 4 ];
+
+    for( int32_t begin = 0; begin < n; begin += chunkSize )
+    {
+        const int32_t size = LB_MIN( chunkSize, n - begin ) * 4;
+        const uint16_t* srcChunk = src + begin * 4;
+        uint16_t* dstChunk = dst + begin * 4;
+
+        for( int32_t i = 0; i < size; ++i )
+        {
+            front[i] = table[ srcChunk[i] ];
+            back[i] = table[ dstChunk[i] ];
+        }
+        _blendRGBA32F( front, back, size / 4 );
+        _floatToHalf( back, dstChunk, size );
+    }
+}
+
+void _blendPixels( const uint32_t format, const uint8_t* src, uint8_t* dst,
+                   const int32_t n )
+{
+    switch( format )
+    {
+    case EQ_COMPRESSOR_DATATYPE_RGBA:
+    case EQ_COMPRESSOR_DATATYPE_BGRA:
+        _blendRGBA( src, dst, n );
+        break;
+    case EQ_COMPRESSOR_DATATYPE_RGB10_A2:
+    case EQ_COMPRESSOR_DATATYPE_BGR10_A2:
+        _blendRGB10A2( reinterpret_cast< const uint32_t* >( src ),
+                       reinterpret_cast< uint32_t* >( dst ), n );
+        break;
+    case EQ_COMPRESSOR_DATATYPE_RGBA16F:
+    case EQ_COMPRESSOR_DATATYPE_BGRA16F:
+        _blendRGBA16F( reinterpret_cast< const uint16_t* >( src ),
+                       reinterpret_cast< uint16_t* >( dst ), n );
+        break;
+    case EQ_COMPRESSOR_DATATYPE_RGBA32F:
+    case EQ_COMPRESSOR_DATATYPE_BGRA32F:
+        _blendRGBA32F( reinterpret_cast< const float* >( src ),
+                       reinterpret_cast< float* >( dst ), n );
+        break;
+    default:
+        LBUNIMPLEMENTED;
     }
 }
 
@@ -351,49 +669,33 @@ void _blendImage( void* dest, const eq::PixelViewport& destPVP,
 {
     LBVERB << "CPU-Blend assembly" << std::endl;
 
-    int32_t* destColor = reinterpret_cast< int32_t* >( dest );
-
     const PixelViewport&  pvp    = image->getPixelViewport();
-    const int32_t         destX  = offset.x() + pvp.x - destPVP.x;
-    const int32_t         destY  = offset.y() + pvp.y - destPVP.y;
+    const Pixel&          pixel  = image->getContext().pixel;
+    const Vector2i        destXY = _getDestPosition( image, destPVP, offset );
 
-    LBASSERT( image->getPixelSize( Frame::Buffer::color ) == 4 );
     LBASSERT( image->hasPixelData( Frame::Buffer::color ));
     LBASSERT( image->hasAlpha( ));
 
-    const int32_t* color = reinterpret_cast< const int32_t* >
-                               ( image->getPixelPointer( Frame::Buffer::color ));
-
-    // Blending of two slices, none of which is on final image (i.e. result
-    // could be blended on to something else) should be performed with:
-    // glBlendFuncSeparate( GL_ONE, GL_SRC_ALPHA, GL_ZERO, GL_SRC_ALPHA )
-    // which means:
-    // dstColor = 1*srcColor + srcAlpha*dstColor
-    // dstAlpha = 0*srcAlpha + srcAlpha*dstAlpha
-    // because we accumulate light which is go through (= 1-Alpha) and we
-    // already have colors as Alpha*Color
+    const uint8_t* color = image->getPixelPointer( Frame::Buffer::color );
+    const size_t pixelSize = image->getPixelSize( Frame::Buffer::color );
+    const uint32_t format = image->getExternalFormat( Frame::Buffer::color );
 
-    int32_t* destColorStart = destColor + destY*destPVP.w + destX;
-    const uint32_t step = sizeof( int32_t );
+    uint8_t* destColorStart = reinterpret_cast< uint8_t* >( dest ) +
+                              ( destXY.y() * destPVP.w + destXY.x( )) *
+                              pixelSize;
 
 #pragma omp parallel for
     for( int32_t y = 0; y < pvp.h; ++y )
     {
-        const unsigned char* src =
-            reinterpret_cast< const uint8_t* >( color + pvp.w * y );
-        unsigned char*       dst =
-            reinterpret_cast< uint8_t* >( destColorStart + destPVP.w * y );
-
-        for( int32_t x = 0; x < pvp.w; ++x )
-        {
-            dst[0] = LB_MIN( src[0] + (src[3]*dst[0] >> 8), 255 );
-            dst[1] = LB_MIN( src[1] + (src[3]*dst[1] >> 8), 255 );
-            dst[2] = LB_MIN( src[2] + (src[3]*dst[2] >> 8), 255 );
-            dst[3] =                   src[3]*dst[3] >> 8;
-
-            src += step;
-            dst += step;
-        }
+        const uint8_t* src = color + pvp.w * y * pixelSize;
+        uint8_t*       dst = destColorStart +
+                             destPVP.w * y * pixel.h * pixelSize;
+
+        if( pixel.w == 1 )
+            _blendPixels( format, src, dst, pvp.w );
+        else for( int32_t x = 0; x < pvp.w; ++x )
+            _blendPixels( format, src + x * pixelSize,
+                          dst + x * pixel.w * pixelSize, 1 );
     }
 }
 
@@ -416,6 +718,400 @@ void _mergeImages( const ImageOps& ops, const bool blend, void* colorBuffer,
     }
 }
 
+/**
+ * Accumulates the color of images in a float buffer, to average subpixel
+ * decompositions on the CPU, see util::Accum for the OpenGL implementation.
+ */
+class CPUAccum
+{
+public:
+    CPUAccum() : _colorInt( 0 ), _colorExt( 0 ), _pixelSize( 0 ), _steps( 0 ) {}
+
+    static bool isSupported( const Image* image )
+    {
+        switch( image->getExternalFormat( Frame::Buffer::color ))
+        {
+        case EQ_COMPRESSOR_DATATYPE_RGBA:
+        case EQ_COMPRESSOR_DATATYPE_BGRA:
+        case EQ_COMPRESSOR_DATATYPE_RGBA16F:
+        case EQ_COMPRESSOR_DATATYPE_BGRA16F:
+        case EQ_COMPRESSOR_DATATYPE_RGBA32F:
+        case EQ_COMPRESSOR_DATATYPE_BGRA32F:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    /**
+     * Add the color of the image. The viewport grows to cover all images, and
+     * each pixel is averaged over the images covering it.
+     */
+    void add( const Image& image )
+    {
+        LBASSERT( isSupported( &image ));
+        if( _steps++ == 0 )
+        {
+            _colorInt = image.getInternalFormat( Frame::Buffer::color );
+            _colorExt = image.getExternalFormat( Frame::Buffer::color );
+            _pixelSize = image.getPixelSize( Frame::Buffer::color );
+        }
+        LBASSERT( _colorExt == image.getExternalFormat( Frame::Buffer::color ));
+
+        const PixelViewport& pvp = image.getPixelViewport();
+        if( !pvp.hasArea( ))
+            return;
+
+        PixelViewport destPVP = _pvp;
+        destPVP.merge( pvp );
+        _grow( destPVP );
+
+        const uint8_t* color = image.getPixelPointer( Frame::Buffer::color );
+        const float* halfToFloat = _getHalfToFloat();
+
+#pragma omp parallel for
+        for( int32_t y = 0; y < pvp.h; ++y )
+        {
+            const size_t srcPixel = size_t( y ) * pvp.w;
+            const size_t destPixel = size_t( pvp.y - _pvp.y + y ) * _pvp.w +
+                                     ( pvp.x - _pvp.x );
+            float* sum = _sum.data() + 4 * destPixel;
+            uint32_t* counts = _counts.data() + destPixel;
+            const int32_t n = pvp.w * 4;
+
+            for( int32_t x = 0; x < pvp.w; ++x )
+                ++counts[x];
+
+            switch( _pixelSize )
+            {
+            case 4:
+            {
+                const uint8_t* src = color + srcPixel * 4;
+                for( int32_t i = 0; i < n; ++i )
+                    sum[i] += src[i];
+                break;
+            }
+            case 8:
+            {
+                const uint16_t* src =
+                    reinterpret_cast< const uint16_t* >( color ) + srcPixel * 4;
+                for( int32_t i = 0; i < n; ++i )
+                    sum[i] += halfToFloat[ src[i] ];
+                break;
+            }
+            case 16:
+            {
+                const float* src =
+                    reinterpret_cast< const float* >( color ) + srcPixel * 4;
+                for( int32_t i = 0; i < n; ++i )
+                    sum[i] += src[i];
+                break;
+            }
+            }
+        }
+    }
+
+    /**
+     * @return the averaged color in the per-thread result image, zero where
+     *         no image was added.
+     */
+    Image* getResult() const
+    {
+        if( !_pvp.hasArea( ))
+            return 0;
+
+        Image* result = _newResultImage( _pvp, _colorInt, _pixelSize,
+                                         _colorExt, 0, 0, 0 );
+        uint8_t* color = result->getPixelPointer( Frame::Buffer::color );
+        const int32_t nPixels = int32_t( _counts.size( ));
+        std::vector< float > weights( nPixels );
+        for( int32_t i = 0; i < nPixels; ++i )
+            weights[i] = _counts[i] == 0 ? 0.f : 1.f / float( _counts[i] );
+        const int32_t n = int32_t( _sum.size( ));
+
+        switch( _pixelSize )
+        {
+        case 4:
+#pragma omp parallel for
+            for( int32_t i = 0; i < n; ++i )
+                color[i] = uint8_t( LB_MIN( _sum[i] * weights[i / 4] + .5f,
+                                            255.f ));
+            break;
+        case 8:
+        {
+            uint16_t* dest = reinterpret_cast< uint16_t* >( color );
+#pragma omp parallel for
+            for( int32_t i = 0; i < n; ++i )
+                dest[i] = half_from_float( _sum[i] * weights[i / 4] );
+            break;
+        }
+        case 16:
+        {
+            float* dest = reinterpret_cast< float* >( color );
+#pragma omp parallel for
+            for( int32_t i = 0; i < n; ++i )
+                dest[i] = _sum[i] * weights[i / 4];
+            break;
+        }
+        }
+        return result;
+    }
+
+    uint32_t getNumSteps() const { return _steps; }
+
+private:
+    PixelViewport _pvp;
+    uint32_t _colorInt;
+    uint32_t _colorExt;
+    uint32_t _pixelSize;
+    uint32_t _steps;
+    std::vector< float > _sum;
+    std::vector< uint32_t > _counts; //!< the number of images per pixel
+
+    /** Grow the buffers to the given viewport, keeping the added pixels. */
+    void _grow( const PixelViewport& pvp )
+    {
+        if( pvp == _pvp )
+            return;
+
+        std::vector< float > sum( size_t( pvp.getArea( )) * 4, 0.f );
+        std::vector< uint32_t > counts( pvp.getArea(), 0 );
+        for( int32_t y = 0; y < _pvp.h; ++y )
+        {
+            const size_t from = size_t( y ) * _pvp.w;
+            const size_t to = size_t( _pvp.y - pvp.y + y ) * pvp.w +
+                              ( _pvp.x - pvp.x );
+            std::copy( _sum.begin() + from * 4,
+                       _sum.begin() + ( from + _pvp.w ) * 4,
+                       sum.begin() + to * 4 );
+            std::copy( _counts.begin() + from,
+                       _counts.begin() + from + _pvp.w, counts.begin() + to );
+        }
+        _pvp = pvp;
+        _sum.swap( sum );
+        _counts.swap( counts );
+    }
+};
+
+bool _useCPUAccum( const ImageOps& ops )
+{
+    for( const ImageOp& op : ops )
+    {
+        if( op.image->getStorageType() != Frame::TYPE_MEMORY ||
+            !op.image->hasPixelData( Frame::Buffer::color ) ||
+            !CPUAccum::isSupported( op.image ) || op.zoom != Zoom::NONE )
+        {
+            return false;
+        }
+    }
+    return !ops.empty();
+}
+
+Image* _accumImagesCPU( const ImageOps& ops, const bool blend,
+                        uint32_t& nSteps )
+{
+    nSteps = 0;
+    if( !_useCPUAccum( ops ))
+        return 0;
+
+    CPUAccum accum;
+    ImageOps opsLeft = ops;
+    while( !opsLeft.empty( ))
+    {
+        const ImageOps current = Compositor::extractOneSubPixel( opsLeft );
+        const Image* image = Compositor::mergeImagesCPU( current, blend );
+        if( image )
+            accum.add( *image );
+    }
+
+    nSteps = accum.getNumSteps();
+    return accum.getResult();
+}
+
+// Edge length of the coverage tiles of a sparse CPU-based assembly
+static const int32_t COVERAGE_TILE = 64;
+
+/**
+ * @return the areas of the destination covered by the images, as rectangles
+ *         of coverage tiles merged row by row, cropped to the images.
+ */
+PixelViewports _getCoverage( const ImageOps& ops, const PixelViewport& destPVP )
+{
+    const int32_t nColumns = ( destPVP.w + COVERAGE_TILE - 1 ) / COVERAGE_TILE;
+    const int32_t nRows = ( destPVP.h + COVERAGE_TILE - 1 ) / COVERAGE_TILE;
+    std::vector< bool > covered( size_t( nColumns ) * nRows, false );
+
+    for( const ImageOp& op : ops )
+    {
+        if( !op.image->hasPixelData( Frame::Buffer::color ))
+            continue;
+
+        const PixelViewport pvp = _getDestPVP( op.image, op.offset );
+        const int32_t x0 = ( pvp.x - destPVP.x ) / COVERAGE_TILE;
+        const int32_t y0 = ( pvp.y - destPVP.y ) / COVERAGE_TILE;
+        const int32_t x1 = ( pvp.getXEnd() - destPVP.x - 1 ) / COVERAGE_TILE;
+        const int32_t y1 = ( pvp.getYEnd() - destPVP.y - 1 ) / COVERAGE_TILE;
+
+        for( int32_t y = y0; y <= y1; ++y )
+            std::fill_n( covered.begin() + y * nColumns + x0, x1 - x0 + 1,
+                         true );
+    }
+
+    // extend the regions of the previous row by identical runs of this row
+    PixelViewports regions;
+    std::vector< size_t > open; // regions ending at the previous row
+    for( int32_t y = 0; y < nRows; ++y )
+    {
+        std::vector< size_t > current;
+        for( int32_t x = 0; x < nColumns; )
+        {
+            if( !covered[ y * nColumns + x ] )
+            {
+                ++x;
+                continue;
+            }
+
+            const int32_t start = x;
+            while( x < nColumns && covered[ y * nColumns + x ] )
+                ++x;
+
+            const PixelViewport run( start * COVERAGE_TILE, y * COVERAGE_TILE,
+                                     ( x - start ) * COVERAGE_TILE,
+                                     COVERAGE_TILE );
+            bool extended = false;
+            for( const size_t i : open )
+            {
+                PixelViewport& region = regions[i];
+                if( region.x == run.x && region.w == run.w )
+                {
+                    region.h += COVERAGE_TILE;
+                    current.push_back( i );
+                    extended = true;
+                    break;
+                }
+            }
+            if( !extended )
+            {
+                current.push_back( regions.size( ));
+                regions.push_back( run );
+            }
+        }
+        open.swap( current );
+    }
+
+    // crop the tiles to the bounding box of the images within them
+    for( PixelViewport& region : regions )
+    {
+        region.x += destPVP.x;
+        region.y += destPVP.y;
+
+        PixelViewport bounds;
+        for( const ImageOp& op : ops )
+        {
+            if( !op.image->hasPixelData( Frame::Buffer::color ))
+                continue;
+
+            PixelViewport pvp = _getDestPVP( op.image, op.offset );
+            pvp.intersect( region );
+            bounds.merge( pvp );
+        }
+        region = bounds;
+    }
+    return regions;
+}
+
+/** Fill the rows of the region with the clear color and far depth. */
+void _clearRegion( SparseResult& sparse, const PixelViewport& destPVP,
+                   const PixelViewport& region, const uint32_t colorInt,
+                   const uint32_t colorExt, const size_t pixelSize,
+                   const bool hasDepth )
+{
+    Image clear; // the clear pixel, see Image::clearPixelData
+    PixelData pixels;
+    pixels.internalFormat = colorInt;
+    pixels.externalFormat = colorExt;
+    pixels.pixelSize = uint32_t( pixelSize );
+    pixels.pvp = PixelViewport( 0, 0, region.w, 1 );
+    clear.setPixelViewport( pixels.pvp );
+    clear.setPixelData( Frame::Buffer::color, pixels );
+    const uint8_t* clearRow = clear.getPixelPointer( Frame::Buffer::color );
+
+    const int32_t yEnd = region.getYEnd();
+#pragma omp parallel for
+    for( int32_t y = region.y; y < yEnd; ++y )
+    {
+        const size_t start = size_t( y - destPVP.y ) * destPVP.w +
+                             ( region.x - destPVP.x );
+        memcpy( sparse.color.data() + start * pixelSize, clearRow,
+                region.w * pixelSize );
+        if( hasDepth )
+            std::fill_n( sparse.depth.data() + start, region.w, 0xffffffffu );
+    }
+}
+
+/**
+ * Grow the sparse buffers from the given area to also cover the given image
+ * area, keeping the merged pixels. Used by the unsorted CPU assembly.
+ */
+void _growRegion( SparseResult& sparse, PixelViewport& destPVP,
+                  const PixelViewport& imagePVP,
+                  const CPUAssemblyFormat& format, const size_t pixelSize )
+{
+    PixelViewport pvp = destPVP;
+    pvp.merge( imagePVP );
+    if( pvp == destPVP )
+        return;
+
+    std::vector< uint8_t > color( size_t( pvp.getArea( )) * pixelSize );
+    std::vector< uint32_t > depth( pvp.getArea( ));
+    sparse.color.swap( color );
+    sparse.depth.swap( depth );
+    _clearRegion( sparse, pvp, pvp, format.colorInt, format.colorExt,
+                  pixelSize, true );
+
+    if( destPVP.hasArea( ))
+    {
+        const size_t rowSize = destPVP.w * pixelSize;
+#pragma omp parallel for
+        for( int32_t y = 0; y < destPVP.h; ++y )
+        {
+            const size_t start = size_t( destPVP.y - pvp.y + y ) * pvp.w +
+                                 ( destPVP.x - pvp.x );
+            memcpy( sparse.color.data() + start * pixelSize,
+                    color.data() + y * rowSize, rowSize );
+            std::copy_n( depth.data() + size_t( y ) * destPVP.w, destPVP.w,
+                         sparse.depth.data() + start );
+        }
+    }
+    destPVP = pvp;
+}
+
+/** Copy one region of the sparse buffers into the given image. */
+void _copyRegion( SparseResult& sparse, const PixelViewport& destPVP,
+                  const PixelViewport& region, PixelData& pixels,
+                  const uint8_t* buffer, Image* image,
+                  const Frame::Buffer which )
+{
+    const size_t rowSize = region.w * pixels.pixelSize;
+    const uint8_t* start = buffer + ( size_t( region.y - destPVP.y ) *
+                                      destPVP.w + ( region.x - destPVP.x )) *
+                                    pixels.pixelSize;
+    pixels.pvp = region;
+
+    if( region.w == destPVP.w )
+        pixels.pixels = const_cast< uint8_t* >( start ); // contiguous rows
+    else
+    {
+        sparse.rows.resize( rowSize * region.h );
+        for( int32_t y = 0; y < region.h; ++y )
+            memcpy( sparse.rows.data() + y * rowSize,
+                    start + size_t( y ) * destPVP.w * pixels.pixelSize,
+                    rowSize );
+        pixels.pixels = sparse.rows.data();
+    }
+    image->setPixelData( which, pixels );
+}
+
 Vector4f _getCoords( const ImageOp& op, const PixelViewport& pvp )
 {
     const Pixel& pixel = op.image->getContext().pixel;
@@ -687,8 +1383,8 @@ uint32_t Compositor::assembleFrames( const Frames& frames,
     if( frames.empty( ))
         return 0;
 
-    if( _useCPUAssembly( frames, channel ))
-        return assembleFramesCPU( frames, channel );
+    if( _useCPUAssembly( frames ))
+        return assembleFramesUnsortedCPU( frames, channel );
 
     // else
     return assembleFramesUnsorted( frames, channel, accum );
@@ -702,6 +1398,13 @@ uint32_t Compositor::blendImages( const ImageOps& ops, Channel* channel,
 
     if( isSubPixelDecomposition( ops ))
     {
+        if( !accum )
+        {
+            const uint32_t count = assembleImagesAccumCPU( ops, channel, true );
+            if( count > 0 )
+                return count;
+        }
+
         const bool coreProfile = channel->getWindow()->getIAttribute(
                     WindowSettings::IATTR_HINT_CORE_PROFILE ) == ON;
         if( coreProfile )
@@ -738,7 +1441,10 @@ uint32_t Compositor::blendImages( const ImageOps& ops, Channel* channel,
     }
 
     uint32_t count = 1;
-    if( _useCPUAssembly( ops, true ))
+    const Image* result = ops.size() > 1 ? mergeImagesOrderedCPU( ops ) : 0;
+    if( result )
+        count = _assembleCPUImage( result, channel );
+    else if( _useCPUAssembly( ops, true ))
         count = assembleImagesCPU( ops, channel, true );
     else for( const ImageOp& op : ops )
         assembleImage( op, channel );
@@ -748,6 +1454,15 @@ uint32_t Compositor::blendImages( const ImageOps& ops, Channel* channel,
 uint32_t Compositor::blendFrames( const Frames& frames, Channel* channel,
                                   util::Accum* accum )
 {
+    // blend the frames on the CPU while they arrive, if possible
+    if( !accum && !isSubPixelDecomposition( frames ))
+    {
+        const uint32_t timeout = channel->getConfig()->getTimeout();
+        const Image* result = mergeFramesOrderedCPU( frames, timeout );
+        if( result )
+            return _assembleCPUImage( result, channel );
+    }
+
     ImageOps ops;
     for( const Frame* frame : frames )
     {
@@ -849,6 +1564,29 @@ uint32_t Compositor::assembleFramesUnsorted( const Frames& frames,
     LBVERB << "Unsorted GPU assembly" << std::endl;
     if( isSubPixelDecomposition( frames ))
     {
+        if( !accum )
+        {
+            // accumulate on the CPU if all images are supported, otherwise
+            // continue below with the ready frames
+            ImageOps ops;
+            WaitHandle* handle = startWaitFrames( frames, channel );
+            for( Frame* frame = waitFrame( handle ); frame;
+                 frame = waitFrame( handle ))
+            {
+                for( const Image* image : frame->getImages( ))
+                {
+                    ImageOp op( frame, image );
+                    op.offset = frame->getOffset();
+                    ops.push_back( op );
+                }
+            }
+
+            const uint32_t count = assembleImagesAccumCPU( ops, channel,
+                                                           false );
+            if( count > 0 )
+                return count;
+        }
+
         const bool coreProfile = channel->getWindow()->getIAttribute(
                     WindowSettings::IATTR_HINT_CORE_PROFILE ) == ON;
         if( coreProfile )
@@ -997,8 +1735,8 @@ uint32_t Compositor::assembleFramesCPU( const Frames& frames, Channel* channel,
     if( frames.empty( ))
         return 0;
 
-    // Assembles images from DB and 2D compounds using the CPU and then
-    // assembles the result image. Does not support Pixel or Eye compounds.
+    // Assembles images from DB, 2D and Pixel compounds using the CPU and then
+    // assembles the result image. Does not support Eye compounds.
     LBVERB << "Sorted CPU assembly" << std::endl;
 
     const Image* result = mergeFramesCPU( frames, blend,
@@ -1006,6 +1744,83 @@ uint32_t Compositor::assembleFramesCPU( const Frames& frames, Channel* channel,
     return _assembleCPUImage( result, channel );
 }
 
+uint32_t Compositor::assembleFramesUnsortedCPU( const Frames& frames,
+                                                Channel* channel )
+{
+    if( frames.empty( ))
+        return 0;
+
+    // Merges the images into a memory buffer in the order they become
+    // available, overlapping the merge with waiting on the remaining frames.
+    // The buffer grows to the union of the merged images. Images not supported
+    // by the CPU compositor are assembled directly.
+    LBVERB << "Unsorted CPU assembly" << std::endl;
+
+    const PixelViewport& channelPVP = channel->getPixelViewport();
+    if( !_sparseResult )
+        _sparseResult = new SparseResult;
+    SparseResult& sparse = *_sparseResult;
+    PixelViewport destPVP( 0, 0, 0, 0 );
+    CPUAssemblyFormat format( false );
+    uint32_t colorPixelSize = 0;
+    uint32_t depthPixelSize = 0;
+    uint32_t count = 0;
+
+    WaitHandle* handle = startWaitFrames( frames, channel );
+    for( Frame* frame = waitFrame( handle ); frame; frame = waitFrame( handle ))
+    {
+        for( const Image* image : frame->getImages( ))
+        {
+            ImageOp op( frame, image );
+            op.offset = frame->getOffset();
+            count = 1;
+
+            const PixelViewport imagePVP = _getDestPVP( image, op.offset );
+            PixelViewport pvp = imagePVP;
+            pvp.intersect( channelPVP );
+
+            if( image->getStorageType() != Frame::TYPE_MEMORY ||
+                pvp != imagePVP ||
+                !_useCPUAssembly( image, format ))
+            {
+                assembleImage( op, channel );
+                continue;
+            }
+
+            colorPixelSize = image->getPixelSize( Frame::Buffer::color );
+            depthPixelSize = image->getPixelSize( Frame::Buffer::depth );
+            _growRegion( sparse, destPVP, imagePVP, format, colorPixelSize );
+            _mergeDBImage( sparse.color.data(), sparse.depth.data(), destPVP,
+                           image, op.offset );
+        }
+    }
+
+    if( !destPVP.hasArea( ))
+        return count;
+
+    if( !_resultImage )
+        _resultImage = new Image;
+    Image* result = _resultImage.get();
+    result->setPixelViewport( destPVP );
+
+    PixelData pixels;
+    pixels.internalFormat = format.colorInt;
+    pixels.externalFormat = format.colorExt;
+    pixels.pixelSize = colorPixelSize;
+    _copyRegion( sparse, destPVP, destPVP, pixels, sparse.color.data(),
+                 result, Frame::Buffer::color );
+
+    pixels.internalFormat = format.depthInt;
+    pixels.externalFormat = format.depthExt;
+    pixels.pixelSize = depthPixelSize;
+    _copyRegion( sparse, destPVP, destPVP, pixels,
+                 reinterpret_cast< const uint8_t* >( sparse.depth.data( )),
+                 result, Frame::Buffer::depth );
+
+    _assembleCPUImage( result, channel );
+    return count;
+}
+
 uint32_t Compositor::assembleImagesCPU( const ImageOps& images,
                                         Channel* channel,
                                         const bool blend )
@@ -1013,12 +1828,83 @@ uint32_t Compositor::assembleImagesCPU( const ImageOps& images,
     if( images.empty( ))
         return 0;
 
-    // Assembles images from DB and 2D compounds using the CPU and then
-    // assembles the result image. Does not support Pixel or Eye compounds.
+    // Assembles images from DB, 2D and Pixel compounds using the CPU and then
+    // assembles the result image. Does not support Eye compounds.
     LBVERB << "Sorted CPU assembly" << std::endl;
 
-    const Image* result = mergeImagesCPU( images, blend );
-    return _assembleCPUImage( result, channel );
+    uint32_t count = 0;
+    for( const Image* result : mergeImagesSparseCPU( images, blend ))
+        count = _assembleCPUImage( result, channel );
+    return count;
+}
+
+Images Compositor::mergeImagesSparseCPU( const ImageOps& ops,
+                                         const bool blend )
+{
+    LBVERB << "Sparse CPU assembly" << std::endl;
+
+    // Collect input image information and check preconditions
+    PixelViewport destPVP;
+    uint32_t colorInt = 0;
+    uint32_t colorExt = 0;
+    uint32_t colorPixelSize = 0;
+    uint32_t depthInt = 0;
+    uint32_t depthExt = 0;
+    uint32_t depthPixelSize = 0;
+
+    if( !_collectOutputData( ops, destPVP, colorInt, colorPixelSize,
+                             colorExt, depthInt, depthPixelSize, depthExt ))
+    {
+        return Images();
+    }
+
+    if( !_sparseResult )
+        _sparseResult = new SparseResult;
+    SparseResult& sparse = *_sparseResult;
+
+    // only the covered regions of the merge buffers are initialized
+    const size_t nPixels = destPVP.getArea();
+    sparse.color.resize( nPixels * colorPixelSize );
+    sparse.depth.resize( depthInt == 0 ? 0 : nPixels );
+
+    const PixelViewports regions = _getCoverage( ops, destPVP );
+    for( const PixelViewport& region : regions )
+        _clearRegion( sparse, destPVP, region, colorInt, colorExt,
+                      colorPixelSize, depthInt != 0 );
+
+    _mergeImages( ops, blend, sparse.color.data(),
+                  depthInt == 0 ? 0 : sparse.depth.data(), destPVP );
+
+    Images images;
+    for( size_t i = 0; i < regions.size(); ++i )
+    {
+        if( i == sparse.images.size( ))
+            sparse.images.push_back( new Image );
+
+        const PixelViewport& region = regions[i];
+        Image* image = sparse.images[i];
+        image->setPixelViewport( region );
+
+        PixelData pixels;
+        pixels.internalFormat = colorInt;
+        pixels.externalFormat = colorExt;
+        pixels.pixelSize = colorPixelSize;
+        _copyRegion( sparse, destPVP, region, pixels, sparse.color.data(),
+                     image, Frame::Buffer::color );
+
+        if( depthInt != 0 )
+        {
+            pixels.internalFormat = depthInt;
+            pixels.externalFormat = depthExt;
+            pixels.pixelSize = depthPixelSize;
+            _copyRegion( sparse, destPVP, region, pixels,
+                         reinterpret_cast< const uint8_t* >(
+                             sparse.depth.data( )),
+                         image, Frame::Buffer::depth );
+        }
+        images.push_back( image );
+    }
+    return images;
 }
 
 const Image* Compositor::mergeFramesCPU( const Frames& frames, const bool blend,
@@ -1038,6 +1924,95 @@ const Image* Compositor::mergeFramesCPU( const Frames& frames, const bool blend,
     return mergeImagesCPU( ops, blend );
 }
 
+const Image* Compositor::mergeFramesOrderedCPU( const Frames& frames,
+                                                const uint32_t timeout )
+{
+    if( frames.size() < 2 || !_useOrderedCPUBlending( frames ))
+        return 0;
+
+    // Each frame is one slot of the visibility order. Ready frames are combined
+    // with their ready neighbours while waiting for the remaining frames.
+    lunchbox::Monitor< uint32_t > monitor;
+    for( Frame* frame : frames )
+        frame->addListener( monitor );
+
+    detail::OrderedBlender blender( frames.size( ));
+    std::vector< bool > added( frames.size(), false );
+    CPUAssemblyFormat format( true );
+    bool supported = true;
+
+    for( uint32_t nAdded = 0; nAdded < frames.size(); )
+    {
+        if( !monitor.timedWaitGE( nAdded + 1, timeout ))
+        {
+            _removeListener( frames, monitor );
+            throw Exception( Exception::TIMEOUT_INPUTFRAME );
+        }
+
+        for( size_t i = 0; i < frames.size(); ++i )
+        {
+            const Frame* frame = frames[i];
+            if( added[i] || !frame->isReady( ))
+                continue;
+
+            added[i] = true;
+            ++nAdded;
+
+            Images images;
+            for( Image* image : frame->getImages( ))
+            {
+                if( !image->hasPixelData( Frame::Buffer::color ))
+                    continue;
+                if( !_useOrderedCPUBlending( image, format ))
+                    supported = false;
+                images.push_back( image );
+            }
+            if( supported )
+                blender.add( i, images, frame->getOffset( ));
+        }
+    }
+    _removeListener( frames, monitor );
+
+    if( !supported )
+        return 0;
+
+    if( !_resultImage )
+        _resultImage = new Image;
+    Image* result = _resultImage.get();
+    return blender.finish( *result ) ? result : 0;
+}
+
+const Image* Compositor::mergeImagesOrderedCPU( const ImageOps& ops )
+{
+    CPUAssemblyFormat format( true );
+    for( const ImageOp& op : ops )
+    {
+        const RenderContext& context = op.image->getContext();
+        if( context.pixel != Pixel::ALL || context.subPixel != SubPixel::ALL ||
+            op.zoom != Zoom::NONE ||
+            ( op.image->hasPixelData( Frame::Buffer::color ) &&
+              !_useOrderedCPUBlending( op.image, format )))
+        {
+            return 0;
+        }
+    }
+
+    // Each image is one slot of the visibility order
+    detail::OrderedBlender blender( ops.size( ));
+    for( size_t i = 0; i < ops.size(); ++i )
+    {
+        if( ops[i].image->hasPixelData( Frame::Buffer::color ))
+            blender.add( i, ops[i].image, ops[i].offset );
+        else
+            blender.add( i, Images(), ops[i].offset );
+    }
+
+    if( !_resultImage )
+        _resultImage = new Image;
+    Image* result = _resultImage.get();
+    return blender.finish( *result ) ? result : 0;
+}
+
 const Image* Compositor::mergeImagesCPU( const ImageOps& ops, const bool blend )
 {
     LBVERB << "Sorted CPU assembly" << std::endl;
@@ -1057,36 +2032,11 @@ const Image* Compositor::mergeImagesCPU( const ImageOps& ops, const bool blend )
         return 0;
     }
 
-    // prepare output image
-    if( !_resultImage )
-        _resultImage = new Image;
-    Image* result = _resultImage.get();
-
-    // pre-condition check for current _merge implementations
-    LBASSERT( colorInt != 0 );
-
-    result->setPixelViewport( destPVP );
-
-    PixelData colorPixels;
-    colorPixels.internalFormat = colorInt;
-    colorPixels.externalFormat = colorExt;
-    colorPixels.pixelSize      = colorPixelSize;
-    colorPixels.pvp            = destPVP;
-    result->setPixelData( Frame::Buffer::color, colorPixels );
-
-    void* destDepth = 0;
-    if( depthInt != 0 ) // at least one depth assembly
-    {
-        LBASSERT( depthExt ==
-                  EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT );
-        PixelData depthPixels;
-        depthPixels.internalFormat = depthInt;
-        depthPixels.externalFormat = depthExt;
-        depthPixels.pixelSize      = depthPixelSize;
-        depthPixels.pvp            = destPVP;
-        result->setPixelData( Frame::Buffer::depth, depthPixels );
-        destDepth = result->getPixelPointer( Frame::Buffer::depth );
-    }
+    Image* result = _newResultImage( destPVP, colorInt, colorPixelSize,
+                                     colorExt, depthInt, depthPixelSize,
+                                     depthExt );
+    void* destDepth = depthInt == 0 ? 0 :
+                          result->getPixelPointer( Frame::Buffer::depth );
 
     // assembly
     _mergeImages( ops, blend, result->getPixelPointer( Frame::Buffer::color ),
@@ -1094,6 +2044,26 @@ const Image* Compositor::mergeImagesCPU( const ImageOps& ops, const bool blend )
     return result;
 }
 
+uint32_t Compositor::assembleImagesAccumCPU( const ImageOps& ops,
+                                             Channel* channel,
+                                             const bool blend )
+{
+    LBVERB << "CPU subpixel accumulation" << std::endl;
+
+    uint32_t nSteps = 0;
+    const Image* result = _accumImagesCPU( ops, blend, nSteps );
+    if( !_assembleCPUImage( result, channel ))
+        return 0;
+    return nSteps;
+}
+
+const Image* Compositor::mergeImagesAccumCPU( const ImageOps& ops,
+                                              const bool blend )
+{
+    uint32_t nSteps = 0;
+    return _accumImagesCPU( ops, blend, nSteps );
+}
+
 void Compositor::assembleFrame( const Frame* frame, Channel* channel )
 {
     const Images& images = frame->getImages();
@@ -88,6 +88,25 @@ public:
                                             Channel* channel,
                                             util::Accum* accum );
 
+    /**
+     * Assemble all frames in the order they become available in a memory
+     * buffer using the CPU before assembling the result on the given channel.
+     *
+     * Each depth image is merged as soon as its frame is ready, overlapping the
+     * merge with waiting for the remaining frames. Images not supported by the
+     * CPU compositor are assembled directly on the channel. The memory buffer
+     * grows to the union of the merged images. assembleFrames() only uses
+     * this for frames with color and depth, since the result would overwrite
+     * the destination's own tile in a 2D decomposition.
+     *
+     * @param frames the frames to assemble.
+     * @param channel the destination channel.
+     * @return the number of different subpixel steps assembled (0 or 1).
+     * @version 2.1
+     */
+    static uint32_t assembleFramesUnsortedCPU( const Frames& frames,
+                                               Channel* channel );
+
     /**
      * Assemble all frames in the given order in a memory buffer using the CPU
      * before assembling the result on the given channel.
@@ -114,6 +133,9 @@ public:
      * Merge the provided frames in the given order into one image in main
      * memory.
      *
+     * The color images may be 8 bit, 10 bit, half float or float RGBA or BGRA
+     * images, all of the same format.
+     *
      * The returned image does not have to be freed. The compositor maintains
      * one image per thread, that is, the returned image is valid until the next
      * usage of the compositor in the current thread.
@@ -125,6 +147,100 @@ public:
                                const uint32_t timeout = LB_TIMEOUT_INDEFINITE );
     static const Image* mergeImagesCPU( const ImageOps& ops, const bool blend );
 
+    /**
+     * Blend the provided frames in the given order into one image in main
+     * memory.
+     *
+     * The frames are given in back-to-front order. Each frame is combined
+     * with the already combined frames directly behind and in front of it as
+     * soon as it is ready, while waiting for the remaining frames, which
+     * reduces adjacent frames pairwise. The intermediate results are kept in
+     * floating point, so the result is the same for any arrival order up to
+     * rounding, and more accurate than mergeFramesCPU(). This is used by
+     * blendFrames() when no accumulation buffer is given.
+     *
+     * All images have to be 8 bit RGBA or BGRA color images with alpha in main
+     * memory. The returned image is managed like the one of mergeFramesCPU().
+     *
+     * @param frames the frames to blend, in back-to-front order.
+     * @param timeout the time to wait for each frame, in milliseconds.
+     * @return the result image, or 0 if the frames are not supported or empty.
+     * @throw Exception if a frame does not become ready within the timeout.
+     * @version 2.1
+     */
+    static const Image* mergeFramesOrderedCPU( const Frames& frames,
+                               const uint32_t timeout = LB_TIMEOUT_INDEFINITE );
+
+    /**
+     * Blend the provided images in the given order into one image in main
+     * memory, like mergeFramesOrderedCPU().
+     *
+     * This is used by blendImages() for color-only images.
+     *
+     * @param ops the images to blend, in back-to-front order.
+     * @return the result image, or 0 if the images are not supported or empty.
+     * @version 2.1
+     */
+    static const Image* mergeImagesOrderedCPU( const ImageOps& ops );
+
+    /**
+     * Merge the provided images in the given order into a set of images in
+     * main memory, one per region covered by the input images.
+     *
+     * The destination area is divided into tiles, and only the tiles covered
+     * by at least one input image are initialized and merged. The covered
+     * tiles are combined into rectangular regions, which are cropped to the
+     * bounding box of the input images within them and returned as separate
+     * images. Assembling these images declares only these regions on the
+     * destination channel, which limits the readback of the following output
+     * frames. Pixels of a region not covered by any input image, e.g., between
+     * two images sharing a tile, are cleared.
+     *
+     * The returned images are managed like the image of mergeImagesCPU().
+     *
+     * @param ops the images to merge.
+     * @param blend blend color-only images if they have an alpha channel.
+     * @return the merged images, empty if the images are not supported.
+     * @version 2.1
+     */
+    static Images mergeImagesSparseCPU( const ImageOps& ops, const bool blend );
+
+    /**
+     * Accumulate the subpixel steps of the given images in main memory using
+     * the CPU, before assembling the averaged result on the given channel.
+     *
+     * The images of each subpixel step are merged using mergeImagesCPU(), and
+     * the results are averaged in a floating point buffer. Each pixel is
+     * averaged over the steps covering it, pixels not covered by any step are
+     * cleared to zero. This does not need
+     * OpenGL accumulation support, and is used by blendImages() and
+     * assembleFramesUnsorted() when no accumulation buffer is given.
+     *
+     * @param ops the images to accumulate.
+     * @param channel the destination channel.
+     * @param blend blend color-only images if they have an alpha channel.
+     * @return the number of subpixel steps accumulated, or 0 if the images are
+     *         not supported.
+     * @version 2.1
+     */
+    static uint32_t assembleImagesAccumCPU( const ImageOps& ops,
+                                            Channel* channel,
+                                            const bool blend );
+
+    /**
+     * Accumulate the subpixel steps of the given images into one image in
+     * main memory.
+     *
+     * All images have to be 8 bit, half float or float RGBA or BGRA images in
+     * main memory. The returned image is managed like the one of
+     * mergeFramesCPU().
+     *
+     * @return the averaged image, or 0 if the images are not supported.
+     * @version 2.1
+     */
+    static const Image* mergeImagesAccumCPU( const ImageOps& ops,
+                                             const bool blend );
+
     /**
      * Assemble a frame into the frame buffer using the default algorithm.
      * @version 1.0
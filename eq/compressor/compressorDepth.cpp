@@ -0,0 +1,296 @@
+
+/* Copyright (c) 2017, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "compressorDepth.h"
+
+#include <lunchbox/log.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace eq
+{
+namespace plugin
+{
+namespace
+{
+static const uint32_t FAR_DEPTH = 0xffffffffu;
+static const unsigned DEPTH_LOSSY_BITS = 12;
+static const uint64_t BLOCK_SIZE = 64;  // pixels per mask
+static const uint64_t CHUNK_SIZE = 1 << 18; // pixels per result
+
+// mask, plus at most five bytes per varint residual
+static const uint64_t MAX_BLOCK_BYTES = sizeof( uint64_t ) + BLOCK_SIZE * 5;
+
+static void _getInfo( EqCompressorInfo* const info )
+{
+    info->version         = EQ_COMPRESSOR_VERSION;
+    info->name            = EQ_COMPRESSOR_DEPTH_PREDICT;
+    info->capabilities    = EQ_COMPRESSOR_DATA_1D | EQ_COMPRESSOR_DATA_2D;
+    info->tokenType       = EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT;
+    info->outputTokenType = EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT;
+    info->outputTokenSize = 4;
+    info->quality         = 1.f;
+    info->ratio           = .2f;
+    info->speed           = .8f;
+}
+
+static void _getInfoLossy( EqCompressorInfo* const info )
+{
+    _getInfo( info );
+    info->name            = EQ_COMPRESSOR_DEPTH_PREDICT_LOSSY;
+    info->quality         = .99f;
+    info->ratio           = .15f;
+}
+
+static bool _register()
+{
+    Compressor::registerEngine(
+        Compressor::Functions( EQ_COMPRESSOR_DEPTH_PREDICT,
+                               _getInfo, CompressorDepth::getNewCompressor,
+                               CompressorDepth::getNewDecompressor,
+                               CompressorDepth::decompress, 0 ));
+    Compressor::registerEngine(
+        Compressor::Functions( EQ_COMPRESSOR_DEPTH_PREDICT_LOSSY,
+                               _getInfoLossy, CompressorDepth::getNewCompressor,
+                               CompressorDepth::getNewDecompressor,
+                               CompressorDepth::decompress, 0 ));
+    return true;
+}
+
+static bool _initialized LB_UNUSED = _register();
+
+uint64_t _getNumChunks( const uint64_t nPixels )
+{
+    return std::max( ( nPixels + CHUNK_SIZE - 1 ) / CHUNK_SIZE, uint64_t( 1 ));
+}
+
+// Linear extrapolation of the two previous covered pixels. All arithmetic is
+// modulo 2^32, which makes the coding exact for any input.
+class Predictor
+{
+public:
+    Predictor() : _last( 0 ), _delta( 0 ), _covered( false ) {}
+
+    uint32_t get() const { return _last + _delta; }
+
+    void update( const uint32_t value )
+    {
+        // restart with a constant prediction after a gap
+        _delta = _covered ? value - _last : 0;
+        _last = value;
+        _covered = true;
+    }
+
+    void skip() { _covered = false; }
+
+private:
+    uint32_t _last;
+    uint32_t _delta;
+    bool _covered;
+};
+
+uint8_t* _writeVarint( uint8_t* out, const uint32_t residual )
+{
+    // zigzag encoding keeps small negative residuals short
+    uint32_t value = ( residual << 1 ) ^ uint32_t( int32_t( residual ) >> 31 );
+    while( value >= 0x80 )
+    {
+        *out++ = uint8_t( value | 0x80 );
+        value >>= 7;
+    }
+    *out++ = uint8_t( value );
+    return out;
+}
+
+/** @return the end of the varint, or 0 if it is not within [in, end). */
+const uint8_t* _readVarint( const uint8_t* in, const uint8_t* const end,
+                            uint32_t& residual )
+{
+    uint32_t value = 0;
+    for( unsigned shift = 0; shift < 35; shift += 7 ) // at most five bytes
+    {
+        if( in == end )
+            return 0;
+
+        const uint8_t byte = *in++;
+        value |= uint32_t( byte & 0x7f ) << shift;
+        if( !( byte & 0x80 ))
+        {
+            residual = ( value >> 1 ) ^ -( value & 1 );
+            return in;
+        }
+    }
+    return 0;
+}
+
+void _compressChunk( const uint32_t* in, const uint64_t nPixels,
+                     const unsigned shift, Compressor::Result& result )
+{
+    const uint64_t nBlocks = ( nPixels + BLOCK_SIZE - 1 ) / BLOCK_SIZE;
+    uint8_t* const start =
+        result.reserve( sizeof( uint64_t ) + nBlocks * MAX_BLOCK_BYTES );
+    ::memcpy( start, &nPixels, sizeof( uint64_t ));
+    uint8_t* out = start + sizeof( uint64_t );
+
+    const uint32_t round = shift ? 1u << ( shift - 1 ) : 0;
+    Predictor predictor;
+    for( uint64_t i = 0; i < nPixels; i += BLOCK_SIZE )
+    {
+        const uint64_t n = std::min( BLOCK_SIZE, nPixels - i );
+        uint64_t mask = 0;
+        for( uint64_t j = 0; j < n; ++j )
+            if( in[ i + j ] != FAR_DEPTH )
+                mask |= uint64_t( 1 ) << j;
+
+        ::memcpy( out, &mask, sizeof( uint64_t ));
+        out += sizeof( uint64_t );
+        if( mask == 0 )
+        {
+            predictor.skip();
+            continue;
+        }
+
+        for( uint64_t j = 0; j < n; ++j )
+        {
+            if( !( mask & ( uint64_t( 1 ) << j )))
+            {
+                predictor.skip();
+                continue;
+            }
+            // quantize to the value reconstructed by the decompressor
+            const uint32_t value = shift ? ( in[ i + j ] >> shift << shift ) |
+                                           round : in[ i + j ];
+            out = _writeVarint( out, value - predictor.get( ));
+            predictor.update( value );
+        }
+    }
+    result.setSize( out - start );
+}
+
+/** @return false if the input ends early, leaving the rest on the far plane */
+bool _decompressChunk( const uint8_t* in, const uint8_t* const end,
+                       const uint64_t nPixels, uint32_t* out )
+{
+    Predictor predictor;
+    for( uint64_t i = 0; i < nPixels; i += BLOCK_SIZE )
+    {
+        const uint64_t n = std::min( BLOCK_SIZE, nPixels - i );
+        if( uint64_t( end - in ) < sizeof( uint64_t ))
+        {
+            std::fill_n( out + i, nPixels - i, FAR_DEPTH );
+            return false;
+        }
+
+        uint64_t mask;
+        ::memcpy( &mask, in, sizeof( uint64_t ));
+        in += sizeof( uint64_t );
+        if( mask == 0 )
+        {
+            std::fill_n( out + i, n, FAR_DEPTH );
+            predictor.skip();
+            continue;
+        }
+
+        for( uint64_t j = 0; j < n; ++j )
+        {
+            if( !( mask & ( uint64_t( 1 ) << j )))
+            {
+                out[ i + j ] = FAR_DEPTH;
+                predictor.skip();
+                continue;
+            }
+            uint32_t residual = 0;
+            in = _readVarint( in, end, residual );
+            if( !in )
+            {
+                std::fill_n( out + i + j, nPixels - i - j, FAR_DEPTH );
+                return false;
+            }
+            const uint32_t value = predictor.get() + residual;
+            out[ i + j ] = value;
+            predictor.update( value );
+        }
+    }
+    return true;
+}
+}
+
+CompressorDepth::CompressorDepth( const unsigned name )
+    : Compressor()
+    , _shift( name == EQ_COMPRESSOR_DEPTH_PREDICT_LOSSY ? DEPTH_LOSSY_BITS : 0 )
+{}
+
+CompressorDepth::~CompressorDepth()
+{}
+
+void CompressorDepth::compress( const void* const inData,
+                                const eq_uint64_t nPixels, const bool )
+{
+    const uint64_t nChunks = _getNumChunks( nPixels );
+    while( _results.size() < nChunks )
+        _results.push_back( new Result );
+    _nResults = unsigned( nChunks );
+
+    // chunks are independent, each starting with a fresh prediction
+    const uint32_t* in = reinterpret_cast< const uint32_t* >( inData );
+    const int64_t nTasks = int64_t( nChunks );
+#pragma omp parallel for
+    for( int64_t i = 0; i < nTasks; ++i )
+    {
+        const uint64_t start = uint64_t( i ) * CHUNK_SIZE;
+        const uint64_t size = std::min( CHUNK_SIZE, nPixels - start );
+        _compressChunk( in + start, size, _shift, *_results[ i ] );
+    }
+}
+
+void CompressorDepth::decompress( const void* const* inData,
+                                  const eq_uint64_t* const inSizes,
+                                  const unsigned nInputs,
+                                  void* const outData,
+                                  const eq_uint64_t nPixels LB_UNUSED,
+                                  const bool )
+{
+    // the chunk headers give the output position of each chunk
+    std::vector< uint64_t > offsets( nInputs + 1, 0 );
+    for( unsigned i = 0; i < nInputs; ++i )
+    {
+        LBASSERT( inSizes[ i ] >= sizeof( uint64_t ));
+        uint64_t size;
+        ::memcpy( &size, inData[ i ], sizeof( uint64_t ));
+        offsets[ i + 1 ] = offsets[ i ] + size;
+    }
+    LBASSERTINFO( offsets.back() == nPixels, offsets.back() << " != " <<
+                  nPixels );
+
+    uint32_t* out = reinterpret_cast< uint32_t* >( outData );
+    const int64_t nTasks = int64_t( nInputs );
+#pragma omp parallel for
+    for( int64_t i = 0; i < nTasks; ++i )
+    {
+        const uint8_t* in = reinterpret_cast< const uint8_t* >( inData[ i ] );
+        if( !_decompressChunk( in + sizeof( uint64_t ), in + inSizes[ i ],
+                               offsets[ i + 1 ] - offsets[ i ],
+                               out + offsets[ i ] ))
+        {
+            LBERROR << "Truncated depth data in chunk " << i << std::endl;
+        }
+    }
+}
+
+}
+}
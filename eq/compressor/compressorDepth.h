@@ -0,0 +1,70 @@
+
+/* Copyright (c) 2017, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_PLUGIN_COMPRESSORDEPTH
+#define EQ_PLUGIN_COMPRESSORDEPTH
+
+#include "compressor.h"
+
+namespace eq
+{
+namespace plugin
+{
+// Names in the private range, until public names are allocated in
+// pression/plugins/compressorTokens.h, which then take precedence.
+#ifndef EQ_COMPRESSOR_DEPTH_PREDICT
+/** The lossless depth compressor. */
+#  define EQ_COMPRESSOR_DEPTH_PREDICT       ( EQ_COMPRESSOR_PRIVATE + 1 )
+/** The lossy depth compressor, dropping the DEPTH_LOSSY_BITS lowest bits. */
+#  define EQ_COMPRESSOR_DEPTH_PREDICT_LOSSY ( EQ_COMPRESSOR_PRIVATE + 2 )
+#endif
+
+/**
+ * A CPU compressor for unsigned integer depth buffers.
+ *
+ * The pixels are coded in blocks of 64 values. Each block starts with a mask
+ * of the pixels not on the far plane, followed by the prediction residuals of
+ * these pixels. The prediction extrapolates the two previous covered pixels,
+ * which is exact for planar surfaces. Blocks on the far plane only store their
+ * mask. The lossy variant drops the lowest bits of the covered pixels, leaving
+ * the far plane exact.
+ */
+class CompressorDepth : public Compressor
+{
+public:
+    explicit CompressorDepth( const unsigned name );
+    virtual ~CompressorDepth();
+
+    static void* getNewCompressor( const unsigned name )
+        { return new CompressorDepth( name ); }
+    static void* getNewDecompressor( const unsigned ) { return 0; }
+
+    static void decompress( const void* const* inData,
+                            const eq_uint64_t* const inSizes,
+                            const unsigned nInputs, void* const outData,
+                            const eq_uint64_t nPixels, const bool useAlpha );
+
+    void compress( const void* const inData, const eq_uint64_t nPixels,
+                   const bool useAlpha ) override;
+
+private:
+    const unsigned _shift; //!< the number of dropped low bits
+};
+
+}
+}
+#endif // EQ_PLUGIN_COMPRESSORDEPTH
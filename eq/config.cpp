@@ -44,6 +44,8 @@
 #include <eq/fabric/sizeEvent.h>
 #include <eq/fabric/task.h>
 
+#include <co/buffer.h>
+#include <co/bufferConnection.h>
 #include <co/object.h>
 #include <co/connectionDescription.h>
 #include <co/global.h>
@@ -55,6 +57,8 @@
 #include <pression/data/CompressorInfo.h>
 #include <pression/plugins/compressor.h>
 
+#include <algorithm>
+
 #ifdef EQUALIZER_USE_GLSTATS
 #  include <GLStats/GLStats.h>
 #else
@@ -94,6 +98,46 @@ private:
     const ChangeType _changeType;
     const co::CompressorInfo _compressor;
 };
+
+/** Send queued statistics after this time in ms, even within a frame. */
+static const int64_t STATISTICS_FLUSH_INTERVAL = 100;
+/** Send queued statistics once this many are queued. */
+static const size_t STATISTICS_FLUSH_SIZE = 1024;
+
+bool _lessSerial( const Statistic& lhs, const Statistic& rhs )
+{
+    return lhs.serial < rhs.serial;
+}
+
+uint32_t _getEventType( const co::ICommand& command )
+{
+    if( !command.isValid( ))
+        return EVENT_UNKNOWN;
+    return EventICommand( command ).getEventType();
+}
+
+/**
+ * Dispatch a merged event through Config::handleEvent( EventICommand ), like
+ * a received event. Used for coalesced motion events.
+ */
+template< class T >
+bool _handleMergedEvent( Config* config, const co::ICommand& received,
+                         const uint32_t type, const T& merged )
+{
+    co::BufferConnectionPtr connection = new co::BufferConnection;
+    EventOCommand oCommand( co::Connections( 1, connection ),
+                            fabric::CMD_CONFIG_EVENT, co::COMMANDTYPE_OBJECT,
+                            config->getID(), config->getInstanceID( ));
+    oCommand << type << merged;
+    oCommand.disable();
+
+    co::Buffer buffer;
+    buffer.swap( connection->getBuffer( ));
+
+    co::ICommand iCommand( received.getLocalNode(), received.getRemoteNode(),
+                           &buffer );
+    return config->handleEvent( EventICommand( iCommand ));
+}
 #ifdef EQUALIZER_USE_GLSTATS
 namespace
 {
@@ -118,6 +162,8 @@ public:
         , unlockedFrame( 0 )
         , finishedFrame( 0 )
         , running( false )
+        , coalesceEvents( false )
+        , lastStatisticsFlush( 0 )
     {
         lunchbox::Log::setClock( &clock );
     }
@@ -145,6 +191,9 @@ public:
     lunchbox::Lockable< GLStats::Data, lunchbox::SpinLock > statistics;
 #endif
 
+    /** Statistics queued for the next batched event to the app node. */
+    lunchbox::Lockable< Statistics, lunchbox::SpinLock > pendingStatistics;
+
     /** The last started frame. */
     uint32_t currentFrame;
     /** The last locally released frame. */
@@ -166,6 +215,12 @@ public:
     /** true while the config is initialized and no window has exited. */
     bool running;
 
+    /** Merge consecutive motion events in handleEvents(). */
+    bool coalesceEvents;
+
+    /** The time of the last flushStatistics(), see pendingStatistics. */
+    int64_t lastStatisticsFlush;
+
     /** Errors from last call to update() */
     Errors errors;
 };
@@ -579,6 +634,38 @@ EventOCommand Config::sendError( const uint32_t type, const Error& error )
     return Super::sendError( getApplicationNode(), type, error );
 }
 
+void Config::sendStatistic( const Statistic& statistic )
+{
+    bool flush = false;
+    {
+        lunchbox::ScopedFastWrite mutex( _impl->pendingStatistics );
+        _impl->pendingStatistics->push_back( statistic );
+        flush = _impl->pendingStatistics->size() >= STATISTICS_FLUSH_SIZE ||
+                getTime() - _impl->lastStatisticsFlush >=
+                    STATISTICS_FLUSH_INTERVAL;
+    }
+    if( flush )
+        flushStatistics();
+}
+
+void Config::flushStatistics()
+{
+    Statistics statistics;
+    {
+        lunchbox::ScopedFastWrite mutex( _impl->pendingStatistics );
+        _impl->lastStatisticsFlush = getTime();
+        if( _impl->pendingStatistics->empty( ))
+            return;
+        statistics.swap( _impl->pendingStatistics.data );
+    }
+
+    // group the statistics of each resource for a compact encoding
+    std::stable_sort( statistics.begin(), statistics.end(), _lessSerial );
+
+    EventOCommand command = sendEvent( EVENT_STATISTICS );
+    fabric::serializeStatistics( command, statistics );
+}
+
 Errors Config::getErrors()
 {
     Errors errors;
@@ -637,6 +724,15 @@ bool Config::handleEvent( EventICommand command )
         addStatistic( command.read< Statistic >( ));
         return false;
 
+    case EVENT_STATISTICS:
+    {
+        Statistics statistics;
+        fabric::deserializeStatistics( command, statistics );
+        for( const Statistic& statistic : statistics )
+            addStatistic( statistic );
+        return false;
+    }
+
     case EVENT_CONFIG_ERROR:
     case EVENT_NODE_ERROR:
     case EVENT_PIPE_ERROR:
@@ -772,7 +868,20 @@ bool Config::checkEvent() const
 
 void Config::handleEvents()
 {
-    for( ;; )
+    if( _impl->coalesceEvents )
+    {
+        // the next event is needed to detect consecutive events
+        co::ICommand next = _impl->eventQueue.tryPop();
+        while( next.isValid( ))
+        {
+            const EventICommand event( next );
+            next = _impl->eventQueue.tryPop();
+
+            if( !_handleCoalescedEvent( event, next ))
+                handleEvent( event );
+        }
+    }
+    else for( ;; )
     {
         EventICommand event = getNextEvent( 0 );
         if( !event.isValid( ))
@@ -786,6 +895,103 @@ void Config::handleEvents()
 #endif
 }
 
+void Config::setEventCoalescing( const bool enable )
+{
+    _impl->coalesceEvents = enable;
+}
+
+bool Config::getEventCoalescing() const
+{
+    return _impl->coalesceEvents;
+}
+
+bool Config::_handleCoalescedEvent( const EventICommand& event,
+                                    co::ICommand& next )
+{
+    const uint32_t type = event.getEventType();
+    if( _getEventType( next ) != type )
+        return false;
+
+    switch( type )
+    {
+    case EVENT_CHANNEL_POINTER_MOTION:
+    case EVENT_WINDOW_POINTER_MOTION:
+    {
+        PointerEvent merged = EventICommand( event ).read< PointerEvent >();
+        size_t nMerged = 0;
+        while( _getEventType( next ) == type )
+        {
+            PointerEvent pointer = EventICommand( next ).read<PointerEvent>();
+            if( pointer.originator != merged.originator ||
+                pointer.buttons != merged.buttons ||
+                pointer.modifiers != merged.modifiers )
+            {
+                break;
+            }
+            pointer.dx += merged.dx;
+            pointer.dy += merged.dy;
+            merged = pointer;
+            next = _impl->eventQueue.tryPop();
+            ++nMerged;
+        }
+        if( nMerged == 0 )
+            return false;
+
+        _handleMergedEvent( this, event, type, merged );
+        return true;
+    }
+
+    case EVENT_MAGELLAN_AXIS:
+    {
+        AxisEvent merged = EventICommand( event ).read< AxisEvent >();
+        size_t nMerged = 0;
+        while( _getEventType( next ) == type )
+        {
+            AxisEvent axis = EventICommand( next ).read< AxisEvent >();
+            if( axis.originator != merged.originator )
+                break;
+
+            axis.xAxis += merged.xAxis;
+            axis.yAxis += merged.yAxis;
+            axis.zAxis += merged.zAxis;
+            axis.xRotation += merged.xRotation;
+            axis.yRotation += merged.yRotation;
+            axis.zRotation += merged.zRotation;
+            merged = axis;
+            next = _impl->eventQueue.tryPop();
+            ++nMerged;
+        }
+        if( nMerged == 0 )
+            return false;
+
+        _handleMergedEvent( this, event, type, merged );
+        return true;
+    }
+
+    case EVENT_OBSERVER_MOTION:
+    {
+        // head matrices are absolute, only the last one is relevant
+        const uint128_t& originator =
+            EventICommand( event ).read< uint128_t >();
+        co::ICommand last;
+        while( _getEventType( next ) == type &&
+               EventICommand( next ).read< uint128_t >() == originator )
+        {
+            last = next;
+            next = _impl->eventQueue.tryPop();
+        }
+        if( !last.isValid( ))
+            return false;
+
+        handleEvent( EventICommand( last ));
+        return true;
+    }
+
+    default:
+        return false;
+    }
+}
+
 void Config::addStatistic( const Statistic& stat LB_UNUSED )
 {
 #ifdef EQUALIZER_USE_GLSTATS
@@ -852,6 +1058,7 @@ void Config::addStatistic( const Statistic& stat LB_UNUSED )
           type.group = "window";
           break;
       case Statistic::NODE_FRAME_DECOMPRESS:
+      case Statistic::NODE_FRAME_WRITE:
           type.group = "node";
           break;
 
@@ -890,6 +1097,7 @@ void Config::addStatistic( const Statistic& stat LB_UNUSED )
       // no break;
 
       case Statistic::WINDOW_FPS:
+      case Statistic::WINDOW_PACING_ERROR:
       case Statistic::NONE:
       case Statistic::ALL:
           return;
@@ -910,6 +1118,9 @@ void Config::addStatistic( const Statistic& stat LB_UNUSED )
           {
               text << " 0x" << std::hex << stat.plugins[1] << std::dec;
           }
+          if( stat.type == Statistic::CHANNEL_FRAME_COMPRESS )
+              text << " q" << unsigned( 100.f * stat.quality ) << "% "
+                   << ( stat.bytes >> 10 ) << "KB";
           item.text = text.str();
           break;
       }
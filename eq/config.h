@@ -405,6 +405,23 @@ public:
      */
     EQ_API virtual void handleEvents();
 
+    /**
+     * Enable or disable the coalescing of motion events in handleEvents().
+     *
+     * When enabled, consecutive pointer motion and Magellan axis events of the
+     * same originator are merged into one event with the accumulated deltas,
+     * which is passed to handleEvent( EventICommand ) like any other event. Of
+     * consecutive observer motion events only the last one is handled.
+     * Disabled by default. Not thread safe.
+     *
+     * @param enable true to coalesce motion events, false otherwise.
+     * @version 2.1
+     */
+    EQ_API void setEventCoalescing( bool enable );
+
+    /** @return true if motion events are coalesced. @version 2.1 */
+    EQ_API bool getEventCoalescing() const;
+
     /**
      * Add an statistic event to the statistics overlay. Thread safe.
      *
@@ -424,6 +441,20 @@ public:
     /** @internal Set up appNode connections configured by server. */
     void setupServerConnections( const std::string& connectionData );
 
+    /**
+     * @internal
+     * Queue a statistic event for the application node. Thread safe.
+     *
+     * Queued statistics are sent in one EVENT_STATISTICS event by
+     * flushStatistics(), which is called at the end of each node frame and
+     * on config exit. Long frames flush once too many statistics are queued
+     * or the last flush is too old.
+     */
+    void sendStatistic( const Statistic& statistic );
+
+    /** @internal Send all queued statistics to the application node. */
+    void flushStatistics();
+
 protected:
     /** @internal */
     EQ_API void attach( const uint128_t& id,
@@ -443,6 +474,13 @@ private:
 
     bool _needsLocalSync() const;
 
+    /**
+     * Merge the given event with the following events of the same source.
+     * @return true if events were merged and handled.
+     */
+    bool _handleCoalescedEvent( const EventICommand& event,
+                                co::ICommand& next );
+
     /** Update statistics for the last finished frame */
     void _updateStatistics();
 
@@ -0,0 +1,49 @@
+
+/* Copyright (c) 2016, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+#ifndef EQ_CPU_PIPE_H
+#define EQ_CPU_PIPE_H
+
+#include <eq/systemPipe.h> // base class
+
+namespace eq
+{
+namespace cpu
+{
+/**
+ * A system pipe for in-memory windows.
+ *
+ * The pipe does not use any GPU, and initialization always succeeds.
+ * @version 2.1
+ */
+class Pipe : public SystemPipe
+{
+public:
+    /** Create a new in-memory pipe. @version 2.1 */
+    explicit Pipe( eq::Pipe* parent ) : SystemPipe( parent ) {}
+
+    /** Destruct this pipe. @version 2.1 */
+    virtual ~Pipe() {}
+
+    bool configInit() override { return true; }
+    void configExit() override {}
+};
+}
+}
+
+#endif // EQ_CPU_PIPE_H
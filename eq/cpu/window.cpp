@@ -0,0 +1,332 @@
+
+/* Copyright (c) 2016, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "window.h"
+
+#include "../frameData.h"
+#include "../image.h"
+#include "../pixelData.h"
+
+#include <eq/fabric/drawableConfig.h>
+#include <lunchbox/os.h>
+#include <pression/plugins/compressor.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace eq
+{
+namespace cpu
+{
+namespace
+{
+// Clip the given area to the window, updating the offset into the area
+bool _clip( const PixelViewport& windowPVP, PixelViewport& pvp,
+            Vector2i& skip )
+{
+    const PixelViewport area = pvp;
+    pvp.intersect( PixelViewport( 0, 0, windowPVP.w, windowPVP.h ));
+    skip.x() = pvp.x - area.x;
+    skip.y() = pvp.y - area.y;
+    return pvp.hasArea();
+}
+}
+
+const uint32_t Window::FAR_DEPTH;
+
+Window::Window( NotifierInterface& parent, const WindowSettings& settings )
+    : SystemWindow( parent, settings )
+{
+}
+
+Window::~Window()
+{
+}
+
+bool Window::configInit()
+{
+    const PixelViewport& pvp = getPixelViewport();
+    if( !pvp.hasArea( ))
+    {
+        LBWARN << "Can't create in-memory window with empty viewport " << pvp
+               << std::endl;
+        return false;
+    }
+
+    resize( pvp );
+    clear( PixelViewport( 0, 0, pvp.w, pvp.h ), Vector4ub( 0, 0, 0, 255 ));
+    return true;
+}
+
+void Window::configExit()
+{
+    std::vector< uint8_t >().swap( _color );
+    std::vector< uint32_t >().swap( _depth );
+}
+
+void Window::queryDrawableConfig( DrawableConfig& config )
+{
+    config.stencilBits = 0;
+    config.colorBits = 8;
+    config.alphaBits = 8;
+    config.accumBits = 0;
+    config.glVersion = 0.f;
+    config.stereo = false;
+    config.doublebuffered = false;
+}
+
+void Window::resize( const PixelViewport& pvp )
+{
+    const size_t size = size_t( pvp.w ) * size_t( pvp.h );
+    _color.resize( size * 4 );
+    _depth.resize( size, FAR_DEPTH );
+    setPixelViewport( pvp );
+}
+
+void Window::clear( const PixelViewport& area, const Vector4ub& color )
+{
+    const PixelViewport& windowPVP = getPixelViewport();
+    PixelViewport pvp = area;
+    Vector2i skip;
+    if( !_clip( windowPVP, pvp, skip ))
+        return;
+
+    uint32_t value;
+    ::memcpy( &value, color.array, sizeof( value ));
+    uint32_t* colors = reinterpret_cast< uint32_t* >( _color.data( ));
+
+    const int32_t yEnd = pvp.getYEnd();
+#pragma omp parallel for
+    for( int32_t y = pvp.y; y < yEnd; ++y )
+    {
+        const size_t start = size_t( y ) * windowPVP.w + pvp.x;
+        std::fill_n( colors + start, pvp.w, value );
+        std::fill_n( _depth.data() + start, pvp.w, FAR_DEPTH );
+    }
+}
+
+void Window::fill( const PixelViewport& area, const Vector4ub& color,
+                   const uint32_t depth )
+{
+    const PixelViewport& windowPVP = getPixelViewport();
+    PixelViewport pvp = area;
+    Vector2i skip;
+    if( !_clip( windowPVP, pvp, skip ))
+        return;
+
+    uint32_t value;
+    ::memcpy( &value, color.array, sizeof( value ));
+    uint32_t* colors = reinterpret_cast< uint32_t* >( _color.data( ));
+
+    const int32_t yEnd = pvp.getYEnd();
+#pragma omp parallel for
+    for( int32_t y = pvp.y; y < yEnd; ++y )
+    {
+        const size_t start = size_t( y ) * windowPVP.w + pvp.x;
+        uint32_t* colorIt = colors + start;
+        uint32_t* depthIt = _depth.data() + start;
+
+        for( int32_t x = 0; x < pvp.w; ++x, ++colorIt, ++depthIt )
+        {
+            if( depth < *depthIt )
+            {
+                *colorIt = value;
+                *depthIt = depth;
+            }
+        }
+    }
+}
+
+void Window::readback( Frame& frame, const PixelViewport& region,
+                       const DrawableConfig& config,
+                       const RenderContext& context )
+{
+    FrameDataPtr frameData = frame.getFrameData();
+    const Frame::Buffer buffers = frameData->getBuffers();
+    if( buffers == Frame::Buffer::none )
+        return;
+
+    if( frame.getZoom() != Zoom::NONE )
+    {
+        LBWARN << "Zoomed readback not supported by in-memory windows"
+               << std::endl;
+        return;
+    }
+
+    // see FrameData::startReadback
+    const PixelViewport& framePVP = frameData->getPixelViewport();
+    const PixelViewport absPVP = framePVP + frame.getOffset();
+    PixelViewport pvp = region + frame.getOffset();
+    pvp.intersect( absPVP );
+
+    const PixelViewport& windowPVP = getPixelViewport();
+    Vector2i skip;
+    if( !absPVP.isValid() || !_clip( windowPVP, pvp, skip ))
+        return;
+
+    Image* image = frameData->newImage( Frame::TYPE_MEMORY, config );
+    image->setContext( context );
+    image->setPixelViewport( pvp );
+
+    // rows are contiguous in the window buffers for full-width regions
+    const bool contiguous = pvp.w == windowPVP.w;
+    const size_t start = size_t( pvp.y ) * windowPVP.w + pvp.x;
+
+    if( buffers & Frame::Buffer::color )
+    {
+        PixelData pixels;
+        pixels.internalFormat =
+            image->getInternalFormat( Frame::Buffer::color );
+        pixels.externalFormat = EQ_COMPRESSOR_DATATYPE_RGBA;
+        pixels.pixelSize = 4;
+        pixels.pvp = pvp;
+        if( contiguous )
+            pixels.pixels = _color.data() + start * 4;
+        image->setPixelData( Frame::Buffer::color, pixels );
+
+        if( !contiguous )
+        {
+            uint8_t* dest = image->getPixelPointer( Frame::Buffer::color );
+            for( int32_t y = 0; y < pvp.h; ++y )
+                ::memcpy( dest + size_t( y ) * pvp.w * 4,
+                          _color.data() + ( start + y * windowPVP.w ) * 4,
+                          pvp.w * 4 );
+        }
+    }
+
+    if( buffers & Frame::Buffer::depth )
+    {
+        image->setInternalFormat( Frame::Buffer::depth,
+                                  EQ_COMPRESSOR_DATATYPE_DEPTH );
+        PixelData pixels;
+        pixels.internalFormat = EQ_COMPRESSOR_DATATYPE_DEPTH;
+        pixels.externalFormat = EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT;
+        pixels.pixelSize = 4;
+        pixels.pvp = pvp;
+        if( contiguous )
+            pixels.pixels = _depth.data() + start;
+        image->setPixelData( Frame::Buffer::depth, pixels );
+
+        if( !contiguous )
+        {
+            uint32_t* dest = reinterpret_cast< uint32_t* >(
+                image->getPixelPointer( Frame::Buffer::depth ));
+            for( int32_t y = 0; y < pvp.h; ++y )
+                ::memcpy( dest + size_t( y ) * pvp.w,
+                          _depth.data() + start + y * windowPVP.w,
+                          pvp.w * sizeof( uint32_t ));
+        }
+    }
+
+    pvp -= frame.getOffset();
+    image->setOffset( ( pvp.x - framePVP.x ) * context.pixel.w,
+                      ( pvp.y - framePVP.y ) * context.pixel.h );
+}
+
+void Window::assemble( const Image& image, const Vector2i& offset,
+                       const bool blend )
+{
+    if( !image.hasPixelData( Frame::Buffer::color ))
+        return;
+
+    if( image.getExternalFormat( Frame::Buffer::color ) !=
+            EQ_COMPRESSOR_DATATYPE_RGBA ||
+        image.getContext().pixel != Pixel::ALL )
+    {
+        LBWARN << "Unsupported image for in-memory assembly" << std::endl;
+        return;
+    }
+
+    const PixelViewport& imagePVP = image.getPixelViewport();
+    const PixelViewport& windowPVP = getPixelViewport();
+    PixelViewport pvp = imagePVP + offset;
+    Vector2i skip;
+    if( !_clip( windowPVP, pvp, skip ))
+        return;
+
+    const uint32_t* color = reinterpret_cast< const uint32_t* >(
+        image.getPixelPointer( Frame::Buffer::color ));
+    uint32_t* colors = reinterpret_cast< uint32_t* >( _color.data( ));
+
+    if( image.hasPixelData( Frame::Buffer::depth ))
+    {
+        LBASSERT( image.getExternalFormat( Frame::Buffer::depth ) ==
+                  EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT );
+        const uint32_t* depth = reinterpret_cast< const uint32_t* >(
+            image.getPixelPointer( Frame::Buffer::depth ));
+
+#pragma omp parallel for
+        for( int32_t y = 0; y < pvp.h; ++y )
+        {
+            const size_t dest = size_t( pvp.y + y ) * windowPVP.w + pvp.x;
+            const size_t src = size_t( skip.y() + y ) * imagePVP.w + skip.x();
+            uint32_t* destColorIt = colors + dest;
+            uint32_t* destDepthIt = _depth.data() + dest;
+            const uint32_t* colorIt = color + src;
+            const uint32_t* depthIt = depth + src;
+
+            for( int32_t x = 0; x < pvp.w; ++x )
+            {
+                if( *destDepthIt > *depthIt )
+                {
+                    *destColorIt = *colorIt;
+                    *destDepthIt = *depthIt;
+                }
+                ++destColorIt;
+                ++destDepthIt;
+                ++colorIt;
+                ++depthIt;
+            }
+        }
+        return;
+    }
+
+    if( blend && image.hasAlpha( ))
+    {
+        // see Compositor _blendImage
+#pragma omp parallel for
+        for( int32_t y = 0; y < pvp.h; ++y )
+        {
+            const uint8_t* src = reinterpret_cast< const uint8_t* >(
+                color + size_t( skip.y() + y ) * imagePVP.w + skip.x( ));
+            uint8_t* dst = reinterpret_cast< uint8_t* >(
+                colors + size_t( pvp.y + y ) * windowPVP.w + pvp.x );
+
+            for( int32_t x = 0; x < pvp.w; ++x, src += 4, dst += 4 )
+            {
+                dst[0] = LB_MIN( src[0] + (src[3]*dst[0] >> 8), 255 );
+                dst[1] = LB_MIN( src[1] + (src[3]*dst[1] >> 8), 255 );
+                dst[2] = LB_MIN( src[2] + (src[3]*dst[2] >> 8), 255 );
+                dst[3] =                   src[3]*dst[3] >> 8;
+            }
+        }
+        return;
+    }
+
+#pragma omp parallel for
+    for( int32_t y = 0; y < pvp.h; ++y )
+    {
+        const size_t dest = size_t( pvp.y + y ) * windowPVP.w + pvp.x;
+        ::memcpy( colors + dest,
+                  color + size_t( skip.y() + y ) * imagePVP.w + skip.x(),
+                  pvp.w * sizeof( uint32_t ));
+        std::fill_n( _depth.data() + dest, pvp.w, 0u );
+    }
+}
+
+}
+}
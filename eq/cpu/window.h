@@ -0,0 +1,150 @@
+
+/* Copyright (c) 2016, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_CPU_WINDOW_H
+#define EQ_CPU_WINDOW_H
+
+#include <eq/systemWindow.h> // base class
+#include <eq/frame.h>        // Frame::Buffer enum
+
+#include <vector>
+
+namespace eq
+{
+/**
+ * @namespace eq::cpu
+ * @brief An in-memory window system for rendering without OpenGL.
+ */
+namespace cpu
+{
+/**
+ * A system window rendering into main memory.
+ *
+ * The window has an RGBA color buffer with eight bits per channel and an
+ * unsigned 32 bit depth buffer, both sized to the window's pixel viewport. The
+ * buffers are stored row by row, starting with the bottom row, as in OpenGL.
+ * All GL-related methods are no-ops, and nothing is ever displayed.
+ *
+ * Example usage: @include examples/eqCPU/channel.cpp
+ * @version 2.1
+ */
+class Window : public SystemWindow
+{
+public:
+    /** The depth value of a cleared depth buffer. @version 2.1 */
+    static const uint32_t FAR_DEPTH = 0xffffffffu;
+
+    /** Create a new in-memory window. @version 2.1 */
+    EQ_API Window( NotifierInterface& parent, const WindowSettings& settings );
+
+    /** Destruct this window. @version 2.1 */
+    EQ_API virtual ~Window();
+
+    EQ_API bool configInit() override;
+    EQ_API void configExit() override;
+    void makeCurrent( bool /*cache*/ ) const override {}
+    void doneCurrent() const override {}
+    void bindFrameBuffer() const override {}
+    void bindDrawFrameBuffer() const override {}
+    void updateFrameBuffer() const override {}
+    void swapBuffers() override {}
+    void flush() override {}
+    void finish() override {}
+    void joinNVSwapBarrier( const uint32_t, const uint32_t ) override {}
+    EQ_API void queryDrawableConfig( DrawableConfig& config ) override;
+    EQ_API void resize( const PixelViewport& pvp ) override;
+
+    /** @name Pixel access */
+    //@{
+    /** @return the RGBA color buffer of the window. @version 2.1 */
+    uint8_t* getColorBuffer() { return _color.data(); }
+
+    /** @return the RGBA color buffer of the window. @version 2.1 */
+    const uint8_t* getColorBuffer() const { return _color.data(); }
+
+    /** @return the depth buffer of the window. @version 2.1 */
+    uint32_t* getDepthBuffer() { return _depth.data(); }
+
+    /** @return the depth buffer of the window. @version 2.1 */
+    const uint32_t* getDepthBuffer() const { return _depth.data(); }
+    //@}
+
+    /** @name Operations */
+    //@{
+    /**
+     * Clear the given area to the given color and the far depth.
+     *
+     * @param pvp the area, relative to the window.
+     * @param color the clear color.
+     * @version 2.1
+     */
+    EQ_API void clear( const PixelViewport& pvp, const Vector4ub& color );
+
+    /**
+     * Fill the given area with a color, using a less-than depth test.
+     *
+     * @param pvp the area, relative to the window.
+     * @param color the fill color.
+     * @param depth the depth value of the area.
+     * @version 2.1
+     */
+    EQ_API void fill( const PixelViewport& pvp, const Vector4ub& color,
+                      uint32_t depth );
+
+    /**
+     * Read back the given region into new memory images of the given frame.
+     *
+     * This is the in-memory equivalent of Frame::startReadback() for
+     * Frame::TYPE_MEMORY frames. The images have the same formats, offsets and
+     * alpha usage as images downloaded from OpenGL.
+     *
+     * @param frame the output frame.
+     * @param region the area to read, relative to the window.
+     * @param config the drawable config of the channel.
+     * @param context the render context of the channel.
+     * @version 2.1
+     */
+    EQ_API void readback( Frame& frame, const PixelViewport& region,
+                          const DrawableConfig& config,
+                          const RenderContext& context );
+
+    /**
+     * Draw an image into the window buffers.
+     *
+     * Images with depth are depth-tested against the window. Images with alpha
+     * are blended, if requested. Other images are copied.
+     *
+     * @param image the image in memory, in RGBA and DEPTH_UNSIGNED_INT format.
+     * @param offset the image position relative to the window.
+     * @param blend true to blend images with alpha.
+     * @version 2.1
+     */
+    EQ_API void assemble( const Image& image, const Vector2i& offset,
+                          bool blend );
+    //@}
+
+private:
+    std::vector< uint8_t > _color;
+    std::vector< uint32_t > _depth;
+
+    Window( const Window& ) = delete;
+    Window& operator=( const Window& ) = delete;
+};
+}
+}
+
+#endif // EQ_CPU_WINDOW_H
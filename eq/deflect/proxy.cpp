@@ -34,16 +34,25 @@
 #include <lunchbox/buffer.h>
 #include <deflect/Stream.h>
 
+#include <algorithm>
+#include <chrono>
+
 namespace eq
 {
 namespace deflect
 {
 
-::deflect::Stream::Future make_ready_future( const bool value )
+namespace
 {
-    std::promise< bool > promise;
-    promise.set_value( value );
-    return promise.get_future();
+// Frames queued in the stream before the pipe thread waits
+static const size_t MAX_IN_FLIGHT = 3;
+
+// JPEG quality range and adaptation steps
+static const int MAX_QUALITY = 100;
+static const int MIN_QUALITY = 50;
+static const int QUALITY_DECREASE = 10;
+static const int QUALITY_INCREASE = 2;
+static const size_t INCREASE_INTERVAL = 10; // frames sent in time
 }
 
 class Proxy::Impl : public boost::noncopyable
@@ -51,7 +60,10 @@ class Proxy::Impl : public boost::noncopyable
 public:
     explicit Impl( Channel& channel )
         : _channel( channel )
-        , _sendFuture( make_ready_future( false ))
+        , _sends( MAX_IN_FLIGHT )
+        , _nextSend( 0 )
+        , _quality( MAX_QUALITY )
+        , _nInTime( 0 )
         , _running( false )
     {
         const DrawableConfig& dc = _channel.getDrawableConfig();
@@ -76,28 +88,46 @@ public:
         }
 
         _running = true;
-        _sendFuture = make_ready_future( true );
     }
 
     ~Impl()
     {
-        // wait for completion of previous send
-        _sendFuture.wait();
+        // wait for completion of all pending sends
+        for( Send& send : _sends )
+            if( send.future.valid( ))
+                send.future.wait();
     }
 
     void notifyNewImage( Channel& channel, const Image& image )
     {
         LBASSERT( &channel == &_channel );
 
-        // wait for completion of previous send
-        _running = _sendFuture.get();
+        // wait for completion of the oldest send, which owns the buffer
+        Send& send = _sends[ _nextSend ];
+        _nextSend = ( _nextSend + 1 ) % _sends.size();
+        if( send.future.valid( ))
+        {
+            const bool late = send.future.wait_for( std::chrono::seconds( 0 ))
+                              != std::future_status::ready;
+            if( !send.future.get( ))
+                _running = false;
+            _adaptQuality( late );
+        }
+        if( !_running )
+            return;
 
-        // copy pixels to perform swapYAxis()
-        const size_t dataSize = image.getPixelDataSize( Frame::Buffer::color );
-        _buffer.replace( image.getPixelPointer( Frame::Buffer::color ), dataSize);
+        // copy pixels bottom-up, Deflect expects the first row on top
         const PixelViewport& pvp = image.getPixelViewport();
-        ::deflect::ImageWrapper::swapYAxis( _buffer.getData(), pvp.w, pvp.h,
-                                     image.getPixelSize( Frame::Buffer::color ));
+        const size_t rowSize =
+            pvp.w * image.getPixelSize( Frame::Buffer::color );
+        const uint8_t* src = image.getPixelPointer( Frame::Buffer::color );
+        send.buffer.resize( rowSize * pvp.h );
+        uint8_t* dst = send.buffer.getData();
+
+#pragma omp parallel for
+        for( int32_t y = 0; y < pvp.h; ++y )
+            memcpy( dst + y * rowSize, src + ( pvp.h - 1 - y ) * rowSize,
+                    rowSize );
 
         // determine image offset wrt global view
         const Viewport& vp = channel.getViewport();
@@ -106,20 +136,48 @@ public:
         const int32_t offsX = vp.x * width;
         const int32_t offsY = height - (vp.y * height + vp.h * height);
 
-        ::deflect::ImageWrapper imageWrapper( _buffer.getData(), pvp.w, pvp.h,
+        ::deflect::ImageWrapper imageWrapper( dst, pvp.w, pvp.h,
                                               ::deflect::BGRA, offsX, offsY );
         imageWrapper.compressionPolicy = ::deflect::COMPRESSION_ON;
-        imageWrapper.compressionQuality = 100;
+        imageWrapper.compressionQuality = _quality;
 
-        _sendFuture = _stream->asyncSend( imageWrapper );
+        send.future = _stream->asyncSend( imageWrapper );
     }
 
+    /** A frame being sent, the buffer is used until the future is ready. */
+    struct Send
+    {
+        lunchbox::Bufferb buffer;
+        ::deflect::Stream::Future future;
+    };
+
     std::unique_ptr< ::deflect::Stream > _stream;
     std::unique_ptr< EventHandler > _eventHandler;
     Channel& _channel;
-    lunchbox::Bufferb _buffer;
-    ::deflect::Stream::Future _sendFuture;
+    std::vector< Send > _sends;
+    size_t _nextSend;
+    int _quality;
+    size_t _nInTime;
     bool _running;
+
+private:
+    /**
+     * Lower the JPEG quality quickly when the stream falls behind the
+     * rendering, and raise it slowly while all frames are sent in time.
+     */
+    void _adaptQuality( const bool late )
+    {
+        if( late )
+        {
+            _quality = std::max( _quality - QUALITY_DECREASE, MIN_QUALITY );
+            _nInTime = 0;
+        }
+        else if( ++_nInTime >= INCREASE_INTERVAL )
+        {
+            _quality = std::min( _quality + QUALITY_INCREASE, MAX_QUALITY );
+            _nInTime = 0;
+        }
+    }
 };
 
 Proxy::Proxy( Channel& channel )
@@ -20,6 +20,7 @@
 #include "../channel.h"
 #include "../image.h"
 #include "../resultImageListener.h"
+#include "../transmitQuality.h"
 #include "fileFrameWriter.h"
 
 #ifdef EQUALIZER_USE_DEFLECT
@@ -47,6 +48,9 @@ public:
 #ifdef EQUALIZER_USE_DEFLECT
         , _deflectProxy( 0 )
 #endif
+        , transmitFrame( LB_UNDEFINED_UINT32 )
+        , transmitStart( 0 )
+        , transmitTime( 0 )
         , _updateFrameBuffer( false )
     {
         lunchbox::RNG rng;
@@ -182,6 +186,16 @@ public:
     /** Image of the current framebuffer if result listeners are present */
     eq::Image framebufferImage;
 
+    /** The covered pixels of a DB image during transmission */
+    eq::Image packedImage;
+
+    /** The adaptive loss of the image transmission */
+    eq::TransmitQuality transmitQuality;
+    uint32_t transmitFrame; //!< The frame of the last transmission
+    int64_t transmitStart; //!< The first transmission of transmitFrame
+    int64_t transmitTime; //!< The transmission time of transmitFrame
+    RenderContext transmitContext; //!< To detect camera motion
+
 #ifdef EQUALIZER_USE_DEFLECT
     deflect::Proxy* _deflectProxy;
 #endif
@@ -17,33 +17,217 @@
 
 #include "fileFrameWriter.h"
 
+#include "../nodeStatistics.h"
+
 #include <eq/channel.h>
 #include <eq/image.h>
+#include <eq/node.h>
 
+#include <lunchbox/clock.h>
 #include <lunchbox/log.h>
 
+#include <algorithm>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+
 namespace eq
 {
 namespace detail
 {
+namespace
+{
+size_t _getNumThreads()
+{
+    return std::max( std::thread::hardware_concurrency() / 2, 1u );
+}
+}
+
+/** The queue and writer threads shared by all channels of a node. */
+class FileFrameWriter::Pool
+{
+public:
+    explicit Pool( Node* node )
+        : _node( node )
+        , _compress( getenv( "EQ_DUMP_IMAGE_RLE" ) != 0 )
+        , _drop( getenv( "EQ_DUMP_IMAGE_DROP" ) != 0 )
+        , _maxQueued( 2 * _getNumThreads( ))
+        , _running( true )
+    {
+        const size_t nThreads = _getNumThreads();
+        for( size_t i = 0; i < nThreads; ++i )
+            _threads.push_back( std::thread( &Pool::_run, this ));
+    }
+
+    ~Pool()
+    {
+        {
+            std::lock_guard< std::mutex > lock( _lock );
+            _running = false;
+        }
+        _pushed.notify_all();
+
+        for( std::thread& thread : _threads )
+            thread.join();
+
+        LBINFO << "Wrote " << _stats.written << " images in "
+               << _stats.writeTime << " ms, " << _stats.dropped << " dropped, "
+               << _stats.failed << " failed, waited " << _stats.waitTime
+               << " ms for " << _stats.maxQueued << " queued images"
+               << std::endl;
+    }
+
+    /** @return the pool of the given node, created on first use. */
+    static std::shared_ptr< Pool > get( Node* node )
+    {
+        static std::mutex lock;
+        static std::map< Node*, std::weak_ptr< Pool > > pools;
+
+        std::lock_guard< std::mutex > mutex( lock );
+        std::shared_ptr< Pool > pool = pools[ node ].lock();
+        if( !pool )
+        {
+            pool.reset( new Pool( node ));
+            pools[ node ] = pool;
+        }
+        return pool;
+    }
+
+    void push( const std::string& fileName, const uint32_t frameNumber,
+               const eq::Image& image )
+    {
+        Job job;
+        job.fileName = fileName;
+        job.frameNumber = frameNumber;
+        job.image = 0;
+
+        std::unique_lock< std::mutex > lock( _lock );
+        if( _queue.size() >= _maxQueued )
+        {
+            if( _drop )
+            {
+                ++_stats.dropped;
+                LBVERB << "Dropped " << job.fileName << std::endl;
+                return;
+            }
+
+            const lunchbox::Clock clock;
+            while( _queue.size() >= _maxQueued )
+                _popped.wait( lock );
+            _stats.waitTime += clock.getTimef();
+        }
+
+        // copy outside of the lock, concurrent pipes may each overfill the
+        // queue by one image
+        lock.unlock();
+        job.image = new Image( image );
+        lock.lock();
+
+        _queue.push_back( job );
+        _stats.maxQueued = std::max( _stats.maxQueued, _queue.size( ));
+        lock.unlock();
+        _pushed.notify_one();
+    }
+
+private:
+    /** Writer statistics, logged on destruction. */
+    struct Stats
+    {
+        Stats() : written( 0 ), dropped( 0 ), failed( 0 ), maxQueued( 0 )
+                , waitTime( 0.f ), writeTime( 0.f ) {}
+
+        size_t written;   //!< Number of images written
+        size_t dropped;   //!< Number of images dropped on a full queue
+        size_t failed;    //!< Number of images which could not be written
+        size_t maxQueued; //!< Highest number of queued images
+        float waitTime;   //!< Time the pipe threads waited for the queue, ms
+        float writeTime;  //!< Time spent encoding and writing by all threads
+    };
+
+    struct Job
+    {
+        std::string fileName;
+        uint32_t frameNumber;
+        Image* image;
+    };
+
+    Node* const _node;
+    const bool _compress;
+    const bool _drop;
+    const size_t _maxQueued;
+
+    std::mutex _lock;
+    std::condition_variable _pushed;
+    std::condition_variable _popped;
+    std::deque< Job > _queue;
+    bool _running;
+    Stats _stats;
+
+    std::vector< std::thread > _threads;
+
+    void _run()
+    {
+        std::unique_lock< std::mutex > lock( _lock );
+        for( ;; )
+        {
+            while( _queue.empty() && _running )
+                _pushed.wait( lock );
+            if( _queue.empty( )) // write all pending images before exiting
+                return;
+
+            const Job job = _queue.front();
+            _queue.pop_front();
+            lock.unlock();
+            _popped.notify_one();
+
+            const lunchbox::Clock clock;
+            bool ok = false;
+            {
+                NodeStatistics stat( Statistic::NODE_FRAME_WRITE, _node,
+                                     job.frameNumber );
+                ok = job.image->writeImage( job.fileName,
+                                            eq::Frame::Buffer::color,
+                                            _compress );
+            }
+            delete job.image;
+            const float time = clock.getTimef();
+            if( !ok )
+                LBWARN << "Could not write file " << job.fileName << std::endl;
+
+            lock.lock();
+            _stats.writeTime += time;
+            if( ok )
+                ++_stats.written;
+            else
+                ++_stats.failed;
+        }
+    }
+};
+
 FileFrameWriter::FileFrameWriter()
     : ResultImageListener()
 {
 }
 
+FileFrameWriter::~FileFrameWriter()
+{
+}
+
 void FileFrameWriter::notifyNewImage( eq::Channel& channel,
                                       const eq::Image& image )
 {
     const std::string& prefix =
             channel.getSAttribute( eq::Channel::SATTR_DUMP_IMAGE );
     LBASSERT( !prefix.empty( ));
-    const std::string fileName = prefix + channel.getDumpImageFileName();
-    if( !image.writeImage( fileName, eq::Frame::Buffer::color ))
-        LBWARN << "Could not write file " << fileName << std::endl;
-}
 
-FileFrameWriter::~FileFrameWriter()
-{
+    if( !_pool ) // lazy start, only dumping channels need the writer threads
+        _pool = Pool::get( channel.getNode( ));
+
+    _pool->push( prefix + channel.getDumpImageFileName(),
+                 channel.getCurrentFrame(), image );
 }
 
 }
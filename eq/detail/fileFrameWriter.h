@@ -21,6 +21,8 @@
 #include <eq/resultImageListener.h> // base class
 #include <eq/types.h>
 
+#include <memory>
+
 namespace eq
 {
 namespace detail
@@ -29,6 +31,13 @@ namespace detail
 /**
  * Persist the color buffer of a channel to a file.
  * The name of the file is Channel::SATTR_DUMP_IMAGE.rgb
+ *
+ * Images are copied into a bounded queue and written by background threads,
+ * each encoding a whole image. The queue and threads are shared by all writers
+ * of a node. When the queue is full, the pipe thread waits for a free slot, or
+ * drops the image if EQ_DUMP_IMAGE_DROP is set. Files are written uncompressed,
+ * or run-length encoded if EQ_DUMP_IMAGE_RLE is set. Each write is sampled as a
+ * Statistic::NODE_FRAME_WRITE.
  */
 class FileFrameWriter : public ResultImageListener
 {
@@ -37,6 +46,10 @@ public:
     ~FileFrameWriter();
 
     void notifyNewImage( eq::Channel& channel, const eq::Image& image ) final;
+
+private:
+    class Pool;
+    std::shared_ptr< Pool > _pool;
 };
 
 }
@@ -0,0 +1,207 @@
+/* Copyright (c) 2016, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "orderedBlender.h"
+
+#include <eq/image.h>
+#include <eq/pixelData.h>
+
+#include <lunchbox/log.h>
+
+#include <algorithm>
+
+namespace eq
+{
+namespace detail
+{
+namespace
+{
+/** @return the pixel at the given absolute position. */
+template< class P > P* _getPixel( P* pixels, const PixelViewport& pvp,
+                                  const int32_t x, const int32_t y )
+{
+    return pixels + 4 * ( size_t( y - pvp.y ) * pvp.w + ( x - pvp.x ));
+}
+
+/** Grow the pixels of the run to the given pvp, filled with the identity. */
+template< class R > void _grow( R& run, const PixelViewport& pvp )
+{
+    if( pvp == run.pvp || !pvp.hasArea( ))
+        return;
+
+    std::vector< float > pixels( pvp.getArea() * 4, 0.f );
+    for( size_t i = 3; i < pixels.size(); i += 4 )
+        pixels[i] = 1.f;
+
+    for( int32_t y = run.pvp.y; y < run.pvp.getYEnd(); ++y )
+        std::copy( _getPixel( run.pixels.data(), run.pvp, run.pvp.x, y ),
+                   _getPixel( run.pixels.data(), run.pvp, run.pvp.x, y + 1 ),
+                   _getPixel( pixels.data(), pvp, run.pvp.x, y ));
+    run.pvp = pvp;
+    run.pixels.swap( pixels );
+}
+
+/** Blend n pixels of a front run onto the back run, see class doc. */
+void _blendPixels( const float* front, float* back, const int32_t n )
+{
+    for( int32_t i = 0; i < n; ++i, front += 4, back += 4 )
+    {
+        const float alpha = front[3];
+        back[0] = front[0] + alpha * back[0];
+        back[1] = front[1] + alpha * back[1];
+        back[2] = front[2] + alpha * back[2];
+        back[3] = alpha * back[3];
+    }
+}
+
+/** Combine the front run onto the back run, which covers both afterwards. */
+template< class R > void _combine( R& back, const R& front )
+{
+    if( !front.pvp.hasArea( ))
+        return;
+
+    PixelViewport pvp = back.pvp;
+    pvp.merge( front.pvp );
+    _grow( back, pvp );
+
+    // the front run is the identity outside of its images
+#pragma omp parallel for
+    for( int32_t y = 0; y < front.pvp.h; ++y )
+        _blendPixels( _getPixel( front.pixels.data(), front.pvp, front.pvp.x,
+                                 front.pvp.y + y ),
+                      _getPixel( back.pixels.data(), back.pvp, front.pvp.x,
+                                 front.pvp.y + y ),
+                      front.pvp.w );
+}
+}
+
+OrderedBlender::OrderedBlender( const size_t nSlots )
+    : _nSlots( nSlots )
+    , _internalFormat( 0 )
+    , _externalFormat( 0 )
+{}
+
+OrderedBlender::~OrderedBlender()
+{}
+
+void OrderedBlender::add( const size_t slot, const Images& images,
+                          const Vector2i& offset )
+{
+    LBASSERT( slot < _nSlots );
+
+    Run run;
+    PixelViewport pvp;
+    for( const Image* image : images )
+        pvp.merge( image->getPixelViewport() + offset );
+    _grow( run, pvp );
+
+    // The images of one slot don't overlap
+    for( const Image* image : images )
+        _convert( run, image, offset );
+    _insert( slot, run );
+}
+
+void OrderedBlender::add( const size_t slot, const Image* image,
+                          const Vector2i& offset )
+{
+    LBASSERT( slot < _nSlots );
+
+    Run run;
+    _grow( run, image->getPixelViewport() + offset );
+    _convert( run, image, offset );
+    _insert( slot, run );
+}
+
+bool OrderedBlender::finish( Image& result )
+{
+    LBASSERT( _runs.size() == 1 );
+    LBASSERT( _runs.begin()->first == 0 &&
+              _runs.begin()->second.end == _nSlots );
+    if( _runs.empty( ))
+        return false;
+
+    const Run& run = _runs.begin()->second;
+    if( !run.pvp.hasArea( ))
+        return false;
+
+    std::vector< uint8_t > bytes( run.pixels.size( ));
+    for( size_t i = 0; i < bytes.size(); ++i )
+        bytes[i] = uint8_t( std::min( std::max( run.pixels[i], 0.f ), 1.f ) *
+                            255.f + .5f );
+
+    result.setPixelViewport( run.pvp );
+
+    PixelData pixels;
+    pixels.internalFormat = _internalFormat;
+    pixels.externalFormat = _externalFormat;
+    pixels.pixelSize = 4;
+    pixels.pvp = run.pvp;
+    pixels.pixels = bytes.data();
+    result.setPixelData( Frame::Buffer::color, pixels );
+    return true;
+}
+
+void OrderedBlender::_convert( Run& run, const Image* image,
+                               const Vector2i& offset )
+{
+    if( _externalFormat == 0 )
+    {
+        _internalFormat = image->getInternalFormat( Frame::Buffer::color );
+        _externalFormat = image->getExternalFormat( Frame::Buffer::color );
+    }
+
+    const PixelViewport pvp = image->getPixelViewport() + offset;
+    const uint8_t* src = image->getPixelPointer( Frame::Buffer::color );
+    const int32_t n = pvp.w * 4;
+
+#pragma omp parallel for
+    for( int32_t y = 0; y < pvp.h; ++y )
+    {
+        const uint8_t* in = src + size_t( y ) * n;
+        float* out = _getPixel( run.pixels.data(), run.pvp, pvp.x, pvp.y + y );
+        for( int32_t i = 0; i < n; ++i )
+            out[i] = float( in[i] ) * ( 1.f / 255.f );
+    }
+}
+
+void OrderedBlender::_insert( const size_t slot, Run& run )
+{
+    run.end = slot + 1;
+
+    // combine with the run of the slots in front
+    Runs::iterator i = _runs.find( run.end );
+    if( i != _runs.end( ))
+    {
+        _combine( run, i->second );
+        run.end = i->second.end;
+        _runs.erase( i );
+    }
+
+    // combine with the run of the slots behind
+    i = _runs.lower_bound( slot );
+    if( i != _runs.begin() && (--i)->second.end == slot )
+    {
+        _combine( i->second, run );
+        i->second.end = run.end;
+        return;
+    }
+
+    LBASSERT( _runs.find( slot ) == _runs.end( ));
+    _runs[ slot ] = std::move( run );
+}
+
+}
+}
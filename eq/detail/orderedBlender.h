@@ -0,0 +1,94 @@
+/* Copyright (c) 2016, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_DETAIL_ORDEREDBLENDER_H
+#define EQ_DETAIL_ORDEREDBLENDER_H
+
+#include <eq/types.h>
+
+#include <map>
+#include <vector>
+
+namespace eq
+{
+namespace detail
+{
+
+/**
+ * Blends images in a given visibility order while they arrive.
+ *
+ * Each slot of the visibility order receives the images of one frame, slot 0
+ * being the back. Slots may be added in any order. An added slot is combined
+ * right away with the runs of consecutive slots directly behind and in front
+ * of it, using the associative over operator: color = front + frontAlpha *
+ * back, alpha = frontAlpha * back. This reduces adjacent slices pairwise, and
+ * only the combination of the last slot with its neighbours remains to be done
+ * when it arrives.
+ *
+ * The runs are kept as premultiplied float pixels, which keeps the result
+ * independent of the reduction order up to float rounding. The result is
+ * converted back to 8 bit by finish().
+ *
+ * Images have to be 8 bit RGBA or BGRA images in main memory, where alpha
+ * is the transmittance of the slice.
+ */
+class OrderedBlender
+{
+public:
+    explicit OrderedBlender( size_t nSlots );
+    ~OrderedBlender();
+
+    /** Blend the images of the given slot. */
+    void add( size_t slot, const Images& images, const Vector2i& offset );
+
+    /** Blend the image of the given slot. */
+    void add( size_t slot, const Image* image, const Vector2i& offset );
+
+    /**
+     * Set the result of all slots on the given image.
+     *
+     * @return false if there was nothing to blend.
+     */
+    bool finish( Image& result );
+
+private:
+    /** The blended pixels of the consecutive slots up to end. */
+    struct Run
+    {
+        Run() : end( 0 ) {}
+
+        size_t end;
+        PixelViewport pvp;
+        std::vector< float > pixels; //!< identity outside of the images
+    };
+    typedef std::map< size_t, Run > Runs; //!< indexed by the first slot
+
+    const size_t _nSlots;
+    Runs _runs;
+    uint32_t _internalFormat;
+    uint32_t _externalFormat;
+
+    void _convert( Run& run, const Image* image, const Vector2i& offset );
+    void _insert( size_t slot, Run& run );
+
+    OrderedBlender( const OrderedBlender& ) = delete;
+    OrderedBlender& operator=( const OrderedBlender& ) = delete;
+};
+
+}
+}
+
+#endif // EQ_DETAIL_ORDEREDBLENDER_H
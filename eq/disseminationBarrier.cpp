@@ -0,0 +1,186 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation .
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "disseminationBarrier.h"
+
+#include <eq/fabric/commands.h>
+
+#include <co/connection.h>
+#include <co/localNode.h>
+#include <co/objectOCommand.h>
+#include <lunchbox/clock.h>
+#include <lunchbox/lockable.h>
+#include <lunchbox/log.h>
+#include <lunchbox/monitor.h>
+#include <lunchbox/scopedMutex.h>
+
+#include <map>
+#include <memory>
+#include <set>
+
+namespace eq
+{
+namespace
+{
+/** The rounds of a dissemination barrier received by one participant */
+typedef lunchbox::Monitor< uint32_t > Rounds;
+typedef std::shared_ptr< Rounds > RoundsPtr;
+typedef std::pair< uint128_t, uint32_t > Rank; // barrier, rank
+typedef std::map< Rank, RoundsPtr > Signals;
+typedef Signals::iterator SignalsIter;
+}
+
+namespace detail
+{
+class DisseminationBarrier
+{
+public:
+    /** The received rounds of all entered barriers. */
+    lunchbox::Lockable< Signals > signals;
+
+    /** The timed out barriers, whose late signals are dropped. */
+    std::set< uint128_t > aborted; // protected by signals
+
+    RoundsPtr getRounds( const Rank& rank )
+    {
+        lunchbox::ScopedWrite mutex( signals );
+        RoundsPtr& rounds = signals.data[ rank ];
+        if( !rounds )
+            rounds.reset( new Rounds( 0 ));
+        return rounds;
+    }
+
+    void signal( const Rank& rank, const uint32_t round )
+    {
+        RoundsPtr rounds;
+        {
+            lunchbox::ScopedWrite mutex( signals );
+            if( aborted.count( rank.first ))
+                return;
+
+            RoundsPtr& entry = signals.data[ rank ];
+            if( !entry )
+                entry.reset( new Rounds( 0 ));
+            rounds = entry;
+        }
+        *rounds |= 1u << round;
+    }
+
+    void abort( const uint128_t& barrier )
+    {
+        lunchbox::ScopedWrite mutex( signals );
+        aborted.insert( barrier );
+
+        SignalsIter i = signals->lower_bound( Rank( barrier, 0 ));
+        while( i != signals->end() && i->first.first == barrier )
+            i = signals->erase( i );
+    }
+};
+}
+
+DisseminationBarrier::DisseminationBarrier()
+    : _impl( new detail::DisseminationBarrier )
+{}
+
+DisseminationBarrier::~DisseminationBarrier()
+{
+    delete _impl;
+}
+
+bool DisseminationBarrier::enter( co::LocalNodePtr localNode,
+                                  const uint128_t& barrier, const uint32_t rank,
+                                  const std::vector< uint128_t >& objects,
+                                  const co::NodeIDs& netNodes,
+                                  const std::vector< uint32_t >& ranks,
+                                  const uint32_t timeout )
+{
+    LBASSERT( objects.size() == netNodes.size( ));
+    LBASSERT( objects.size() == ranks.size( ));
+
+    const Rank self( barrier, rank );
+    RoundsPtr rounds = _impl->getRounds( self );
+    const lunchbox::Clock clock;
+    bool success = true;
+
+    for( uint32_t i = 0; i < objects.size() && success; ++i )
+    {
+        if( netNodes[i] == localNode->getNodeID( ))
+            _impl->signal( Rank( barrier, ranks[i] ), i );
+        else
+        {
+            co::NodePtr toNode = localNode->connect( netNodes[i] );
+            if( !toNode )
+            {
+                LBERROR << "Can't connect to " << netNodes[i]
+                        << " to signal barrier " << barrier << std::endl;
+                success = false;
+                break;
+            }
+            co::ObjectOCommand os( co::Connections( 1, toNode->getConnection()),
+                                   fabric::CMD_NODE_BARRIER_SIGNAL,
+                                   co::COMMANDTYPE_OBJECT, objects[i],
+                                   CO_INSTANCE_ALL );
+            os << barrier << ranks[i] << i;
+        }
+
+        // wait for the signal of this round from our predecessor
+        const uint32_t round = 1u << i;
+        uint32_t received = rounds->get();
+        while( !( received & round ))
+        {
+            if( timeout == LB_TIMEOUT_INDEFINITE )
+            {
+                received = rounds->waitNE( received );
+                continue;
+            }
+
+            const int64_t left = int64_t( timeout ) - clock.getTime64();
+            if( left <= 0 || !rounds->timedWaitNE( received, uint32_t( left )))
+            {
+                LBWARN << "Timeout in round " << i << " of barrier " << barrier
+                       << std::endl;
+                success = false;
+                break;
+            }
+            received = rounds->get();
+        }
+    }
+
+    if( success )
+    {
+        lunchbox::ScopedWrite mutex( _impl->signals );
+        _impl->signals->erase( self );
+    }
+    else
+        // Peers may still signal this barrier: drop their signals instead of
+        // accumulating entries nobody waits for anymore.
+        _impl->abort( barrier );
+    return success;
+}
+
+void DisseminationBarrier::signal( const uint128_t& barrier,
+                                   const uint32_t rank, const uint32_t round )
+{
+    _impl->signal( Rank( barrier, rank ), round );
+}
+
+void DisseminationBarrier::clear()
+{
+    lunchbox::ScopedWrite mutex( _impl->signals );
+    _impl->signals->clear();
+    _impl->aborted.clear();
+}
+}
@@ -0,0 +1,74 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation .
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_DISSEMINATIONBARRIER_H
+#define EQ_DISSEMINATIONBARRIER_H
+
+#include <eq/api.h>
+#include <eq/types.h>
+
+#include <co/types.h>
+#include <boost/noncopyable.hpp>
+
+namespace eq
+{
+namespace detail { class DisseminationBarrier; }
+
+/**
+ * @internal
+ * The local endpoint of the dissemination barriers entered on one node.
+ *
+ * In round k of a barrier with n participants, the participant of rank r
+ * signals the participant (r + 2^k) % n and waits for the signal of round k
+ * from its predecessor. The signals are sent as fabric::CMD_NODE_BARRIER_SIGNAL
+ * to the given object of the peer, which has to forward them to signal().
+ */
+class DisseminationBarrier : public boost::noncopyable
+{
+public:
+    EQ_API DisseminationBarrier();
+    EQ_API ~DisseminationBarrier();
+
+    /**
+     * Enter a dissemination barrier.
+     *
+     * @param localNode the local node sending the signals.
+     * @param barrier the unique identifier of the barrier.
+     * @param rank the rank of the entering participant.
+     * @param objects the object to signal in each round.
+     * @param netNodes the network node of each object.
+     * @param ranks the rank to signal in each round.
+     * @param timeout the maximum time to wait, in milliseconds.
+     * @return true if all rounds completed, false on timeout or error.
+     */
+    EQ_API bool enter( co::LocalNodePtr localNode, const uint128_t& barrier,
+                       uint32_t rank, const std::vector< uint128_t >& objects,
+                       const co::NodeIDs& netNodes,
+                       const std::vector< uint32_t >& ranks, uint32_t timeout );
+
+    /** Record the signal of a round for the given barrier participant. */
+    EQ_API void signal( const uint128_t& barrier, uint32_t rank,
+                        uint32_t round );
+
+    /** Forget all pending signals and timed out barriers. */
+    EQ_API void clear();
+
+private:
+    detail::DisseminationBarrier* const _impl;
+};
+}
+
+#endif // EQ_DISSEMINATIONBARRIER_H
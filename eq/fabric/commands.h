@@ -107,6 +107,7 @@ enum NodeCommand
     CMD_NODE_FRAME_TASKS_FINISH,
     CMD_NODE_FRAMEDATA_TRANSMIT,
     CMD_NODE_FRAMEDATA_READY,
+    CMD_NODE_BARRIER_SIGNAL,
     CMD_NODE_CUSTOM
 };
 
@@ -147,6 +148,7 @@ enum WindowCommand
     CMD_WINDOW_THROTTLE_FRAMERATE,
     CMD_WINDOW_BARRIER,
     CMD_WINDOW_NV_BARRIER,
+    CMD_WINDOW_DISSEMINATION_BARRIER,
     CMD_WINDOW_SWAP,
     CMD_WINDOW_FRAME_DRAW_FINISH,
     CMD_WINDOW_CREATE_QGL_WIDGET,
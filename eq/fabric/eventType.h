@@ -73,6 +73,9 @@ enum EventType // Also update string table in event.cpp
      */
     EVENT_OBSERVER_MOTION,
 
+    /** Batched statistic events, see Config::sendStatistic */
+    EVENT_STATISTICS,
+
     /**
      * Config error event. Contains the originator id, the error code and
      * 0-n Strings with additional information.
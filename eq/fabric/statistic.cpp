@@ -17,7 +17,10 @@
 
 #include "statistic.h"
 
+#include <co/dataIStream.h>
+#include <co/dataOStream.h>
 #include <vmmlib/vector.hpp>
+#include <cstring>
 #include <string>
 
 #ifdef _WIN32
@@ -84,6 +87,10 @@ static StatisticData _statisticData[] =
    "finish frame", Vector3f( .5f, .5f, .5f ) },
  { Statistic::CONFIG_WAIT_FINISH_FRAME,
    "wait finish",  Vector3f( 1.0f, 0.f, 0.f ) },
+ { Statistic::WINDOW_PACING_ERROR,
+   "pacing error", Vector3f( 1.f, .5f, 0.f ) },
+ { Statistic::NODE_FRAME_WRITE,
+   "write image",  Vector3f( .5f, 0.f, 1.f ) },
  { Statistic::ALL,
    "ALL EVENTS",   Vector3f( 0.0f, 0.f, 0.f ) }} ;
 }
@@ -100,6 +107,124 @@ const Vector3f& Statistic::getColor( const Type type )
     return _statisticData[ type ].color;
 }
 
+namespace
+{
+bool _isSameOriginator( const Statistic& lhs, const Statistic& rhs )
+{
+    return lhs.originator == rhs.originator && lhs.serial == rhs.serial &&
+           ::strncmp( lhs.resourceName, rhs.resourceName, 32 ) == 0;
+}
+}
+
+void serializeStatistics( co::DataOStream& os, const Statistics& statistics )
+{
+    os << uint64_t( statistics.size( ));
+    if( statistics.empty( ))
+        return;
+
+    int64_t time = statistics.front().startTime;
+    os << time;
+
+    const Statistic* previous = 0;
+    for( const Statistic& stat : statistics )
+    {
+        const bool newOriginator = !previous ||
+                                   !_isSameOriginator( *previous, stat );
+        os << uint32_t( stat.type ) << newOriginator;
+        if( newOriginator )
+            os << stat.originator << stat.serial
+               << std::string( stat.resourceName,
+                               ::strnlen( stat.resourceName, 32 ));
+
+        os << stat.frameNumber << stat.task
+           << int32_t( stat.startTime - time )
+           << int32_t( stat.endTime - stat.startTime )
+           << int32_t( stat.time - stat.startTime );
+        time = stat.startTime;
+        previous = &stat;
+
+        switch( stat.type )
+        {
+          case Statistic::CHANNEL_FRAME_COMPRESS:
+              os << stat.quality << stat.bytes;
+              // no break;
+          case Statistic::CHANNEL_READBACK:
+          case Statistic::CHANNEL_ASYNC_READBACK:
+              os << stat.plugins[0] << stat.plugins[1] << stat.ratio;
+              break;
+          case Statistic::WINDOW_FPS:
+              os << stat.currentFPS << stat.averageFPS;
+              break;
+          case Statistic::WINDOW_PACING_ERROR:
+              os << stat.pacingError;
+              break;
+          case Statistic::PIPE_IDLE:
+              os << stat.idleTime << stat.totalTime;
+              break;
+          default:
+              break;
+        }
+    }
+}
+
+void deserializeStatistics( co::DataIStream& is, Statistics& statistics )
+{
+    const uint64_t size = is.read< uint64_t >();
+    if( size == 0 )
+        return;
+
+    int64_t time = is.read< int64_t >();
+    const size_t first = statistics.size();
+    statistics.resize( first + size );
+
+    for( size_t i = first; i < statistics.size(); ++i )
+    {
+        Statistic& stat = statistics[ i ];
+        stat.type = Statistic::Type( is.read< uint32_t >( ));
+        if( is.read< bool >( ))
+        {
+            is >> stat.originator >> stat.serial;
+            const std::string& name = is.read< std::string >();
+            ::strncpy( stat.resourceName, name.c_str(), 31 );
+        }
+        else
+        {
+            const Statistic& previous = statistics[ i - 1 ];
+            stat.originator = previous.originator;
+            stat.serial = previous.serial;
+            ::memcpy( stat.resourceName, previous.resourceName, 32 );
+        }
+
+        is >> stat.frameNumber >> stat.task;
+        stat.startTime = time + is.read< int32_t >();
+        stat.endTime = stat.startTime + is.read< int32_t >();
+        stat.time = stat.startTime + is.read< int32_t >();
+        time = stat.startTime;
+
+        switch( stat.type )
+        {
+          case Statistic::CHANNEL_FRAME_COMPRESS:
+              is >> stat.quality >> stat.bytes;
+              // no break;
+          case Statistic::CHANNEL_READBACK:
+          case Statistic::CHANNEL_ASYNC_READBACK:
+              is >> stat.plugins[0] >> stat.plugins[1] >> stat.ratio;
+              break;
+          case Statistic::WINDOW_FPS:
+              is >> stat.currentFPS >> stat.averageFPS;
+              break;
+          case Statistic::WINDOW_PACING_ERROR:
+              is >> stat.pacingError;
+              break;
+          case Statistic::PIPE_IDLE:
+              is >> stat.idleTime >> stat.totalTime;
+              break;
+          default:
+              break;
+        }
+    }
+}
+
 std::ostream& operator << ( std::ostream& os, const Statistic::Type& type )
 {
     os << Statistic::getName( type );
@@ -68,6 +68,9 @@ struct Statistic : public Event
         CONFIG_FINISH_FRAME, //!< Sampling of Config::finishFrame
         /** Sampling of synchronization time during Config::finishFrame */
         CONFIG_WAIT_FINISH_FRAME,
+        /** Deviation of a throttled swap from its target time */
+        WINDOW_PACING_ERROR,
+        NODE_FRAME_WRITE, //!< Sampling of writing a dumped image to a file
         ALL          // must be last
     };
 
@@ -80,11 +83,13 @@ struct Statistic : public Event
     int64_t  endTime;    //!< Absolute end time of the operation
     int64_t  idleTime;  //!< Absolute idle time of PIPE_IDLE
     int64_t  totalTime;  //!< Total time of a pipe frame (PIPE_IDLE)
+    uint64_t bytes; //!< Transmitted image size (CHANNEL_FRAME_COMPRESS)
 
     float    ratio; //!< compression ratio (transfer, compression)
+    float    quality; //!< color compression quality (CHANNEL_FRAME_COMPRESS)
     float    currentFPS; //!< FPS of last frame (WINDOW_FPS)
     float    averageFPS; //!< Weighted sum averaging of FPS (WINDOW_FPS)
-    float    pad; //!< @internal
+    float    pacingError; //!< Late swap in ms (WINDOW_PACING_ERROR)
 
     char resourceName[32]; //!< A non-unique name of the originator
 
@@ -100,6 +105,20 @@ EQFABRIC_API std::ostream& operator << ( std::ostream&, const Statistic::Type&);
 /** Output the statistic to an std::ostream. @version 1.0 */
 EQFABRIC_API std::ostream& operator << ( std::ostream&, const Statistic& );
 
+/**
+ * @internal
+ * Write statistics in a compact form.
+ *
+ * The originator of consecutive statistics is only written once, and all times
+ * are delta-encoded. Statistics of one resource should be consecutive.
+ */
+EQFABRIC_API void serializeStatistics( co::DataOStream& os,
+                                       const Statistics& statistics );
+
+/** @internal Append the statistics written by serializeStatistics(). */
+EQFABRIC_API void deserializeStatistics( co::DataIStream& is,
+                                         Statistics& statistics );
+
 }
 }
 
@@ -110,6 +110,18 @@ void Frame::setQuality( const Buffer buffer, const float quality )
         _impl->frameData->setQuality( buffer, quality );
 }
 
+void Frame::setAdaptiveQuality( const Buffer buffer, const float minQuality )
+{
+    if( _impl->frameData )
+        _impl->frameData->setAdaptiveQuality( buffer, minQuality );
+}
+
+void Frame::setMoving( const bool moving )
+{
+    if( _impl->frameData )
+        _impl->frameData->setMoving( moving );
+}
+
 void Frame::useCompressor( const Buffer buffer, const uint32_t name )
 {
     if( _impl->frameData )
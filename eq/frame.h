@@ -92,6 +92,23 @@ public:
     /** Set the minimum quality after compression. @version 1.0 */
     EQ_API void setQuality( const Buffer buffer, const float quality );
 
+    /**
+     * Set the minimum quality of the adaptive transmission.
+     * @sa FrameData::setAdaptiveQuality()
+     * @version 2.1
+     */
+    EQ_API void setAdaptiveQuality( const Buffer buffer,
+                                    const float minQuality );
+
+    /**
+     * Declare the rendering of the following frames as being in motion.
+     *
+     * The flag persists until it is changed.
+     * @sa FrameData::setMoving()
+     * @version 2.1
+     */
+    EQ_API void setMoving( const bool moving );
+
     /** Sets a compressor for compression for following transmissions. */
     EQ_API void useCompressor( const Buffer buffer, const uint32_t name );
     //@}
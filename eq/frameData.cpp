@@ -58,6 +58,9 @@ public:
         , useAlpha( true )
         , colorQuality( 1.f )
         , depthQuality( 1.f )
+        , colorAdaptiveQuality( 1.f )
+        , depthAdaptiveQuality( 1.f )
+        , moving( false )
         , colorCompressor( EQ_COMPRESSOR_AUTO )
         , depthCompressor( EQ_COMPRESSOR_AUTO )
     {}
@@ -81,6 +84,9 @@ public:
     bool useAlpha;
     float colorQuality;
     float depthQuality;
+    float colorAdaptiveQuality;
+    float depthAdaptiveQuality;
+    bool moving;
 
     uint32_t colorCompressor;
     uint32_t depthCompressor;
@@ -135,6 +141,40 @@ void FrameData::setQuality( Frame::Buffer buffer, float quality )
     _impl->colorQuality = quality;
 }
 
+void FrameData::setAdaptiveQuality( const Frame::Buffer buffer,
+                                    const float minQuality )
+{
+    if( buffer != Frame::Buffer::color )
+    {
+        LBASSERT( buffer == Frame::Buffer::depth );
+        _impl->depthAdaptiveQuality = minQuality;
+        return;
+    }
+
+    _impl->colorAdaptiveQuality = minQuality;
+}
+
+float FrameData::getAdaptiveQuality( const Frame::Buffer buffer ) const
+{
+    if( buffer != Frame::Buffer::color )
+    {
+        LBASSERT( buffer == Frame::Buffer::depth );
+        return _impl->depthAdaptiveQuality;
+    }
+
+    return _impl->colorAdaptiveQuality;
+}
+
+void FrameData::setMoving( const bool moving )
+{
+    _impl->moving = moving;
+}
+
+bool FrameData::isMoving() const
+{
+    return _impl->moving;
+}
+
 void FrameData::useCompressor( const Frame::Buffer buffer, const uint32_t name )
 {
     if( buffer != Frame::Buffer::color )
@@ -411,7 +451,7 @@ bool FrameData::addImage( const co::ObjectVersion& frameDataVersion,
                           const PixelViewport& pvp, const Zoom& zoom,
                           const RenderContext& context,
                           const Frame::Buffer buffers_, const bool useAlpha,
-                          uint8_t* data )
+                          const bool packed, uint8_t* data )
 {
     LBASSERT( _impl->readyVersion < frameDataVersion.version.low( ));
     if( _impl->readyVersion >= frameDataVersion.version.low( ))
@@ -423,6 +463,17 @@ bool FrameData::addImage( const co::ObjectVersion& frameDataVersion,
     image->setPixelViewport( pvp );
     image->setAlphaUsage( useAlpha );
 
+    Image::CoverageMask mask;
+    Image packedImage; // the covered pixels of packed images
+    if( packed )
+    {
+        const uint64_t nWords = *reinterpret_cast< uint64_t* >( data );
+        data += sizeof( uint64_t );
+        const uint64_t* words = reinterpret_cast< uint64_t* >( data );
+        mask.assign( words, words + nWords );
+        data += nWords * sizeof( uint64_t );
+    }
+
     Frame::Buffer buffers[] = { Frame::Buffer::color, Frame::Buffer::depth };
     for( unsigned i = 0; i < 2; ++i )
     {
@@ -471,7 +522,14 @@ bool FrameData::addImage( const co::ObjectVersion& frameDataVersion,
             image->setZoom( zoom );
             image->setContext( context );
             image->setQuality( buffer, header->quality );
-            image->setPixelData( buffer, pixelData );
+            if( packed )
+            {
+                packedImage.setPixelViewport( pixelData.pvp );
+                packedImage.setPixelData( buffer, pixelData );
+                image->unpackPixelData( buffer, packedImage, mask );
+            }
+            else
+                image->setPixelData( buffer, pixelData );
         }
     }
 
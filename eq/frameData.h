@@ -94,6 +94,41 @@ public:
      */
     void setQuality( const Frame::Buffer buffer, const float quality );
 
+    /**
+     * Set the minimum quality of the adaptive transmission.
+     *
+     * While the rendering is in motion and the transmission of the images is
+     * the bottleneck, the compression quality is lowered stepwise down to the
+     * given quality. The quality is raised again when the transmission time
+     * allows it, and the first frame without motion is transmitted with the
+     * quality set by setQuality(). The default of 1.0 disables the adaptive
+     * quality.
+     *
+     * @param buffer the frame buffer attachment.
+     * @param minQuality the lowest quality used during motion.
+     * @version 2.1
+     */
+    void setAdaptiveQuality( const Frame::Buffer buffer,
+                             const float minQuality );
+
+    /** @return the minimum adaptive quality of the buffer. @version 2.1 */
+    float getAdaptiveQuality( const Frame::Buffer buffer ) const;
+
+    /**
+     * Declare the rendering of the following frames as being in motion.
+     *
+     * Camera motion of the render context is detected automatically. This
+     * hint covers motion not visible in the render context, e.g., a model
+     * transformation of the application. Like the quality, the flag persists
+     * until it is changed, so applications have to clear it once the motion
+     * stops to get a lossless refinement.
+     * @version 2.1
+     */
+    void setMoving( const bool moving );
+
+    /** @return true if the frames are declared in motion. @version 2.1 */
+    bool isMoving() const;
+
     /**
      * Sets a compressor which will be allocated and used during transmit of
      * the image buffer. The default compressor is EQ_COMPRESSOR_AUTO which
@@ -195,11 +230,16 @@ public:
     void removeListener( Listener& listener );
     //@}
 
-    /** @internal */
+    /**
+     * @internal
+     * Add an image received from the network. Packed images start with the
+     * coverage mask, and their buffers contain only the covered pixels, see
+     * Image::packPixelData().
+     */
     bool addImage( const co::ObjectVersion& frameDataVersion,
                    const PixelViewport& pvp, const Zoom& zoom,
                    const RenderContext& context, const Frame::Buffer buffers,
-                   const bool useAlpha, uint8_t* data );
+                   const bool useAlpha, const bool packed, uint8_t* data );
     void setReady( const co::ObjectVersion& frameData,
                    const fabric::FrameData& data ); //!< @internal
 
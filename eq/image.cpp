@@ -40,6 +40,7 @@
 #include <pression/uploader.h>
 
 #include <boost/filesystem.hpp>
+#include <algorithm>
 #include <fstream>
 
 #ifdef _WIN32
@@ -59,6 +60,32 @@ namespace eq
 {
 namespace
 {
+static const uint32_t FAR_DEPTH = 0xffffffffu;
+
+/** @return the number of coverage segments of one row. */
+int32_t _getNumSegments( const PixelViewport& pvp )
+{
+    return ( pvp.w + Image::COVERAGE_SEGMENT - 1 ) / Image::COVERAGE_SEGMENT;
+}
+
+/** @return the first packed pixel of each row, and the number of pixels. */
+std::vector< size_t > _getCoveredOffsets( const Image::CoverageMask& mask,
+                                          const PixelViewport& pvp )
+{
+    const int32_t nSegments = _getNumSegments( pvp );
+    std::vector< size_t > offsets( pvp.h + 1, 0 );
+    for( int32_t y = 0; y < pvp.h; ++y )
+    {
+        size_t n = 0;
+        for( int32_t i = 0; i < nSegments; ++i )
+            if( Image::isCovered( mask, size_t( y ) * nSegments + i ))
+                n += std::min( Image::COVERAGE_SEGMENT,
+                               pvp.w - i * Image::COVERAGE_SEGMENT );
+        offsets[ y + 1 ] = offsets[ y ] + n;
+    }
+    return offsets;
+}
+
 /** @internal Raw image data. */
 struct Memory : public PixelData
 {
@@ -66,6 +93,7 @@ public:
     Memory()
         : state( INVALID )
         , hasAlpha( true )
+        , downloadQuality( 1.f )
     {}
 
     Memory( const Memory& rhs )
@@ -73,6 +101,7 @@ public:
         , state( rhs.state )
         , localBuffer( rhs.localBuffer )
         , hasAlpha( rhs.hasAlpha )
+        , downloadQuality( rhs.downloadQuality )
     {
         if( rhs.localBuffer.isEmpty( ))
         {
@@ -89,6 +118,7 @@ public:
         state = INVALID;
         localBuffer.clear();
         hasAlpha = true;
+        downloadQuality = 1.f;
     }
 
     void useLocalBuffer()
@@ -117,6 +147,7 @@ public:
     lunchbox::Bufferb localBuffer;
 
     bool hasAlpha; //!< The uncompressed pixels contain alpha
+    float downloadQuality; //!< The quality of the downloaded pixels
 };
 
 co::DataOStream& operator << ( co::DataOStream& os, const Memory& mem )
@@ -244,6 +275,7 @@ public:
         , depth( rhs.depth )
         , ignoreAlpha( rhs.ignoreAlpha )
         , hasPremultipliedAlpha( rhs.hasPremultipliedAlpha )
+        , coverage( rhs.coverage )
     {}
 
     /** The rectangle of the current pixel data. */
@@ -266,6 +298,9 @@ public:
 
     bool hasPremultipliedAlpha;
 
+    /** The covered segments of the depth buffer, empty if unknown. */
+    eq::Image::CoverageMask coverage;
+
     Attachment& getAttachment( const eq::Frame::Buffer buffer )
     {
         switch( buffer )
@@ -312,6 +347,8 @@ public:
 };
 }
 
+const int32_t Image::COVERAGE_SEGMENT;
+
 Image::Image()
     : _impl( new detail::Image )
 {
@@ -513,6 +550,7 @@ void Image::setQuality( const Frame::Buffer buffer, const float quality )
         return;
 
     attachment.quality = quality;
+    attachment.memory.compressedData = pression::CompressorResult();
     if( quality >= 1.f )
         attachment.active = PLUGIN_FULL;
     else
@@ -529,6 +567,163 @@ float Image::getQuality( const Frame::Buffer buffer ) const
     return _impl->getAttachment( buffer ).quality;
 }
 
+float Image::updateCoverage()
+{
+    _impl->coverage.clear();
+    const Memory& memory = _impl->depth.memory;
+    if( memory.state != Memory::VALID ||
+        memory.externalFormat != EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT )
+    {
+        return 1.f;
+    }
+
+    const PixelViewport& pvp = memory.pvp;
+    const int32_t nSegments = _getNumSegments( pvp );
+    const size_t nTotal = size_t( nSegments ) * pvp.h;
+    if( nTotal == 0 )
+        return 1.f;
+
+    CoverageMask& mask = _impl->coverage;
+    mask.resize( ( nTotal + 63 ) / 64, 0 );
+
+    // each iteration computes one mask word, which may span several rows
+    const uint32_t* depth = reinterpret_cast< const uint32_t* >(
+        memory.pixels );
+    const ssize_t nWords = mask.size();
+    size_t nCovered = 0;
+#pragma omp parallel for reduction(+ : nCovered)
+    for( ssize_t i = 0; i < nWords; ++i )
+    {
+        const size_t end = std::min( size_t( i + 1 ) * 64, nTotal );
+        uint64_t word = 0;
+        for( size_t segment = i * 64; segment < end; ++segment )
+        {
+            const int32_t y = int32_t( segment / nSegments );
+            const int32_t x = int32_t( segment % nSegments ) * COVERAGE_SEGMENT;
+            const int32_t n = std::min( COVERAGE_SEGMENT, pvp.w - x );
+            const uint32_t* value = depth + size_t( y ) * pvp.w + x;
+
+            for( int32_t j = 0; j < n; ++j )
+            {
+                if( value[ j ] != FAR_DEPTH )
+                {
+                    word |= uint64_t( 1 ) << ( segment & 63 );
+                    ++nCovered;
+                    break;
+                }
+            }
+        }
+        mask[ i ] = word;
+    }
+    return float( nCovered ) / float( nTotal );
+}
+
+const Image::CoverageMask& Image::getCoverage() const
+{
+    return _impl->coverage;
+}
+
+float Image::getCoverageRatio() const
+{
+    const CoverageMask& mask = _impl->coverage;
+    const PixelViewport& pvp = _impl->depth.memory.pvp;
+    const size_t nTotal = size_t( _getNumSegments( pvp )) * pvp.h;
+    if( mask.empty() || nTotal == 0 )
+        return 1.f;
+
+    size_t nCovered = 0;
+    for( size_t segment = 0; segment < nTotal; ++segment )
+        if( isCovered( mask, segment ))
+            ++nCovered;
+    return float( nCovered ) / float( nTotal );
+}
+
+bool Image::packPixelData( const Frame::Buffer buffer, Image& packed ) const
+{
+    const CoverageMask& mask = _impl->coverage;
+    LBASSERT( !mask.empty( ));
+    const Memory& memory = _impl->getMemory( buffer );
+    LBASSERT( memory.state == Memory::VALID );
+
+    const PixelViewport& pvp = memory.pvp;
+    const std::vector< size_t > offsets = _getCoveredOffsets( mask, pvp );
+    if( offsets.back() == 0 )
+        return false;
+
+    PixelData pixels;
+    pixels.internalFormat = memory.internalFormat;
+    pixels.externalFormat = memory.externalFormat;
+    pixels.pixelSize = memory.pixelSize;
+    pixels.pvp = PixelViewport( 0, 0, int32_t( offsets.back( )), 1 );
+    packed.setPixelViewport( pixels.pvp );
+    packed.setPixelData( buffer, pixels );
+    packed._impl->getMemory( buffer ).downloadQuality = memory.downloadQuality;
+
+    const size_t pixelSize = memory.pixelSize;
+    const int32_t nSegments = _getNumSegments( pvp );
+    const uint8_t* source = reinterpret_cast< const uint8_t* >(
+        memory.pixels );
+    uint8_t* dest = packed.getPixelPointer( buffer );
+
+#pragma omp parallel for
+    for( int32_t y = 0; y < pvp.h; ++y )
+    {
+        uint8_t* out = dest + offsets[ y ] * pixelSize;
+        for( int32_t i = 0; i < nSegments; ++i )
+        {
+            if( !isCovered( mask, size_t( y ) * nSegments + i ))
+                continue;
+            const int32_t x = i * COVERAGE_SEGMENT;
+            const size_t n = std::min( COVERAGE_SEGMENT, pvp.w - x ) *
+                             pixelSize;
+            ::memcpy( out, source + ( size_t( y ) * pvp.w + x ) * pixelSize,
+                      n );
+            out += n;
+        }
+    }
+    return true;
+}
+
+void Image::unpackPixelData( const Frame::Buffer buffer, const Image& packed,
+                             const CoverageMask& mask )
+{
+    const PixelData& source = packed.getPixelData( buffer );
+    const PixelViewport& pvp = _impl->pvp;
+    const std::vector< size_t > offsets = _getCoveredOffsets( mask, pvp );
+    LBASSERTINFO( size_t( source.pvp.getArea( )) == offsets.back(),
+                  source.pvp << " != " << offsets.back( ));
+
+    PixelData pixels;
+    pixels.internalFormat = source.internalFormat;
+    pixels.externalFormat = source.externalFormat;
+    pixels.pixelSize = source.pixelSize;
+    pixels.pvp = pvp;
+    setPixelData( buffer, pixels ); // clears uncovered pixels
+
+    const size_t pixelSize = source.pixelSize;
+    const int32_t nSegments = _getNumSegments( pvp );
+    const uint8_t* in = reinterpret_cast< const uint8_t* >( source.pixels );
+    uint8_t* dest = getPixelPointer( buffer );
+
+#pragma omp parallel for
+    for( int32_t y = 0; y < pvp.h; ++y )
+    {
+        const uint8_t* from = in + offsets[ y ] * pixelSize;
+        for( int32_t i = 0; i < nSegments; ++i )
+        {
+            if( !isCovered( mask, size_t( y ) * nSegments + i ))
+                continue;
+            const int32_t x = i * COVERAGE_SEGMENT;
+            const size_t n = std::min( COVERAGE_SEGMENT, pvp.w - x ) *
+                             pixelSize;
+            ::memcpy( dest + ( size_t( y ) * pvp.w + x ) * pixelSize, from,
+                      n );
+            from += n;
+        }
+    }
+    _impl->coverage = mask;
+}
+
 bool Image::hasTextureData( const Frame::Buffer buffer ) const
 {
     return getTexture( buffer ).isValid();
@@ -679,6 +874,7 @@ bool Image::startReadback( const Frame::Buffer buffer,
     _setExternalFormat( buffer, info.outputTokenType, info.outputTokenSize,
                         alpha );
     attachment.memory.state = Memory::DOWNLOAD;
+    attachment.memory.downloadQuality = info.quality;
 
     if( !memory.hasAlpha )
         flags |= EQ_COMPRESSOR_IGNORE_ALPHA;
@@ -874,6 +1070,7 @@ bool Image::_readbackZoom( const Frame::Buffer buffer, util::ObjectManager& om )
 void Image::setPixelViewport( const PixelViewport& pvp )
 {
     _impl->pvp = pvp;
+    _impl->coverage.clear();
     _impl->color.memory.state = Memory::INVALID;
     _impl->depth.memory.state = Memory::INVALID;
     _impl->color.memory.compressedData = pression::CompressorResult();
@@ -882,6 +1079,9 @@ void Image::setPixelViewport( const PixelViewport& pvp )
 
 void Image::clearPixelData( const Frame::Buffer buffer )
 {
+    if( buffer == Frame::Buffer::depth )
+        _impl->coverage.clear();
+
     Memory& memory = _impl->getAttachment( buffer ).memory;
     memory.pvp = _impl->pvp;
     const ssize_t size = getPixelDataSize( buffer );
@@ -911,6 +1111,38 @@ void Image::clearPixelData( const Frame::Buffer buffer )
 #endif
         break;
       }
+
+      case EQ_COMPRESSOR_DATATYPE_RGB10_A2:
+      case EQ_COMPRESSOR_DATATYPE_BGR10_A2:
+      {
+        uint32_t* data = reinterpret_cast< uint32_t* >( memory.pixels );
+        std::fill_n( data, size / 4, 0x3u ); // alpha in the two LSBs
+        break;
+      }
+
+      case EQ_COMPRESSOR_DATATYPE_RGBA16F:
+      case EQ_COMPRESSOR_DATATYPE_BGRA16F:
+      {
+        uint16_t* data = reinterpret_cast< uint16_t* >( memory.pixels );
+        lunchbox::setZero( data, size );
+        const uint16_t one = half_from_float( 1.f );
+#pragma omp parallel for
+        for( ssize_t i = 3; i < size / 2; i += 4 )
+            data[i] = one;
+        break;
+      }
+
+      case EQ_COMPRESSOR_DATATYPE_RGBA32F:
+      case EQ_COMPRESSOR_DATATYPE_BGRA32F:
+      {
+        float* data = reinterpret_cast< float* >( memory.pixels );
+        lunchbox::setZero( data, size );
+#pragma omp parallel for
+        for( ssize_t i = 3; i < size / 4; i += 4 )
+            data[i] = 1.f;
+        break;
+      }
+
       default:
         LBWARN << "Unknown external format " << memory.externalFormat
                << ", initializing to 0" << std::endl;
@@ -925,10 +1157,14 @@ void Image::validatePixelData( const Frame::Buffer buffer )
     memory.useLocalBuffer();
     memory.state = Memory::VALID;
     memory.compressedData = pression::CompressorResult();
+    memory.downloadQuality = 1.f;
 }
 
 void Image::setPixelData( const Frame::Buffer buffer, const PixelData& pixels )
 {
+    if( buffer == Frame::Buffer::depth )
+        _impl->coverage.clear();
+
     Memory& memory = _impl->getMemory( buffer );
     memory.externalFormat = pixels.externalFormat;
     memory.internalFormat = pixels.internalFormat;
@@ -1078,6 +1314,11 @@ void Image::useCompressor( const Frame::Buffer buffer, const uint32_t name )
     _impl->getMemory( buffer ).compressorName = name;
 }
 
+void Image::invalidateCompressedData( const Frame::Buffer buffer )
+{
+    _impl->getMemory( buffer ).compressedData = pression::CompressorResult();
+}
+
 const PixelData& Image::compressPixelData( const Frame::Buffer buffer )
 {
     LBASSERT( getPixelDataSize( buffer ) > 0 );
@@ -1099,10 +1340,11 @@ const PixelData& Image::compressPixelData( const Frame::Buffer buffer )
     {
         if( memory.compressorName == EQ_COMPRESSOR_AUTO )
         {
+            // The pixels may come from the full quality downloader, or from
+            // setPixelData, even if the attachment uses the lossy plugins.
             const uint32_t tokenType = getExternalFormat( buffer );
-            const float downloadQuality =
-                attachment.downloader[ attachment.active ].getInfo().quality;
-            const float quality = attachment.quality / downloadQuality;
+            const float quality = std::min( attachment.quality /
+                                            memory.downloadQuality, 1.f );
 
             compressor.setup( tokenType, quality, _impl->ignoreAlpha );
         }
@@ -1207,23 +1449,237 @@ struct RGBHeader
 #endif
 ;
 
-void put32f( std::ostream& os, const char* ptr )
+void putBigEndian( std::ostream& os, const std::vector< uint32_t >& values )
 {
+    for( uint32_t value : values )
+    {
+#if defined(__i386__) || defined(__amd64__) || defined (__ia64) || \
+    defined(__x86_64) || defined(_WIN32)
+        SWAP_INT( value );
+#endif
+        os.write( reinterpret_cast< const char* >( &value ), sizeof( value ));
+    }
+}
+
+/**
+ * Reorder interleaved pixels into the channel planes of an rgb file: R or B,
+ * G, B or R and alpha.
+ */
+void planarize( const uint8_t* data, const size_t nPixels,
+                const size_t nChannels, const size_t bpc, const bool swapRB,
+                uint8_t* planes )
+{
+    const size_t depth = nChannels * bpc;
+    const int32_t n = int32_t( nPixels );
+
+    for( size_t i = 0; i < nChannels; ++i )
+    {
+        const bool swap = nChannels >= 3 && !swapRB && ( i == 0 || i == 2 );
+        const uint8_t* src = data + ( swap ? 2 - i : i ) * bpc;
+        uint8_t* dst = planes + i * nPixels * bpc;
+
+        if( bpc == 1 )
+        {
+#pragma omp parallel for
+            for( int32_t j = 0; j < n; ++j )
+                dst[ j ] = src[ j * depth ];
+        }
+        else
+        {
+#pragma omp parallel for
+            for( int32_t j = 0; j < n; ++j )
+                memcpy( dst + j * bpc, src + j * depth, bpc );
+        }
+    }
+}
+
+/**
+ * Reorder the channel planes of an rgb file into interleaved pixels, the
+ * inverse of planarize().
+ */
+void interleave( const uint8_t* planes, const size_t nPixels,
+                 const size_t nChannels, const size_t bpc, const bool swapRB,
+                 uint8_t* data )
+{
+    const size_t depth = nChannels * bpc;
+    const int32_t n = int32_t( nPixels );
+
+    for( size_t i = 0; i < nChannels; ++i )
+    {
+        const bool swap = nChannels >= 3 && !swapRB && ( i == 0 || i == 2 );
+        const uint8_t* src = planes + i * nPixels * bpc;
+        uint8_t* dst = data + ( swap ? 2 - i : i ) * bpc;
+
+        switch( bpc )
+        {
+        case 1:
+#pragma omp parallel for
+            for( int32_t j = 0; j < n; ++j )
+                dst[ j * depth ] = src[ j ];
+            break;
+
+        case 2:
+#pragma omp parallel for
+            for( int32_t j = 0; j < n; ++j )
+                memcpy( dst + j * depth, src + j * 2, 2 );
+            break;
+
+        case 4:
+#pragma omp parallel for
+            for( int32_t j = 0; j < n; ++j )
+                memcpy( dst + j * depth, src + j * 4, 4 );
+            break;
+
+        default:
+#pragma omp parallel for
+            for( int32_t j = 0; j < n; ++j )
+                memcpy( dst + j * depth, src + j * bpc, bpc );
+            break;
+        }
+    }
+}
+
+/** Reciprocals of all alpha values in 16.16 fixed point. */
+struct Reciprocals
+{
+    Reciprocals()
+    {
+        // rounded up, which gives the exact quotient for all color <= alpha
+        values[0] = 0;
+        for( uint32_t i = 1; i < 256; ++i )
+            values[i] = (( 255u << 16 ) + i - 1 ) / i;
+    }
+
+    uint32_t values[256];
+};
+
+/** Post-divide the alpha of premultiplied BGRA pixels. */
+void unpremultiply( const uint32_t* in, const size_t nPixels, uint32_t* out )
+{
+    static const Reciprocals reciprocals;
+    const uint32_t* recip = reciprocals.values;
+    const int32_t n = int32_t( nPixels );
+
+#pragma omp parallel for
+    for( int32_t i = 0; i < n; ++i )
+    {
+        const uint32_t pixel = in[ i ];
+        const uint32_t alpha = pixel >> 24;
+        const uint32_t r = alpha ? recip[ alpha ] : 1u << 16;
+
+        const uint32_t red = std::min((( pixel >> 16 ) & 0xff ) * r >> 16,
+                                      255u );
+        const uint32_t green = std::min((( pixel >> 8 ) & 0xff ) * r >> 16,
+                                        255u );
+        const uint32_t blue = std::min(( pixel & 0xff ) * r >> 16, 255u );
+        out[ i ] = ( alpha << 24 ) | ( red << 16 ) | ( green << 8 ) | blue;
+    }
+}
+
+/** 8 bit values of all half floats. */
+struct HalfToByte
+{
+    HalfToByte()
+    {
+        for( uint32_t i = 0; i < 65536; ++i )
+        {
+            const float value = half_to_float( uint16_t( i ));
+            // clamps NaN to zero
+            values[i] = uint8_t(( value > 0.f ? std::min( value, 1.f ) : 0.f )
+                                * 255.f );
+        }
+    }
+
+    uint8_t values[65536];
+};
+
+/** Convert floating point components to 8 bit, for the s_ preview image. */
+void toUnsignedByte( const uint8_t* in, const size_t nComponents,
+                     const size_t bpc, uint8_t* out )
+{
+    const int32_t n = int32_t( nComponents );
+    if( bpc == 2 )
+    {
+        static const HalfToByte halfToByte;
+        const uint8_t* table = halfToByte.values;
+        const uint16_t* halfs = reinterpret_cast< const uint16_t* >( in );
+
+#pragma omp parallel for
+        for( int32_t i = 0; i < n; ++i )
+            out[ i ] = table[ halfs[ i ]];
+        return;
+    }
+
+    LBASSERTINFO( bpc == 4, bpc );
     // cppcheck-suppress invalidPointerCast
-    const float& value = *reinterpret_cast< const float* >( ptr );
-    const uint8_t byte = uint8_t( value * 255.f );
-    os.write( (const char*)&byte, 1 );
+    const float* floats = reinterpret_cast< const float* >( in );
+
+#pragma omp parallel for
+    for( int32_t i = 0; i < n; ++i )
+    {
+        const float value = floats[ i ];
+        out[ i ] = uint8_t(( value > 0.f ? std::min( value, 1.f ) : 0.f ) *
+                           255.f );
+    }
 }
-void put16f( std::ostream& os, const char* ptr )
+
+/** @return the maximum size of a run-length encoded row. */
+size_t getMaxRLESize( const size_t size )
 {
-    const uint16_t& value = *reinterpret_cast< const uint16_t* >(ptr);
-    const float f = half_to_float( value );
-    put32f( os, (const char*)&f );
+    return size + size / 63 + 2;
+}
+
+/**
+ * Run-length encode one row of a channel plane, see the SGI image file format
+ * specification. @return the size of the encoded row.
+ */
+size_t encodeRLE( const uint8_t* in, const size_t size, uint8_t* out )
+{
+    static const size_t maxCount = 126;
+    uint8_t* const start = out;
+    size_t i = 0;
+
+    while( i < size )
+    {
+        // literal bytes up to the next run of at least three bytes
+        const size_t literal = i;
+        while( i < size &&
+               !( i + 2 < size && in[i] == in[i+1] && in[i] == in[i+2] ))
+        {
+            ++i;
+        }
+        for( size_t j = literal; j < i; )
+        {
+            const size_t count = std::min( i - j, maxCount );
+            *out++ = uint8_t( 0x80 | count );
+            memcpy( out, in + j, count );
+            out += count;
+            j += count;
+        }
+        if( i == size )
+            break;
+
+        const size_t run = i;
+        const uint8_t value = in[i];
+        while( i < size && in[i] == value && i - run < maxCount )
+            ++i;
+        *out++ = uint8_t( i - run );
+        *out++ = value;
+    }
+
+    *out++ = 0;
+    return out - start;
 }
 }
 
 bool Image::writeImage( const std::string& filename,
                         const Frame::Buffer buffer ) const
+{
+    return writeImage( filename, buffer, false );
+}
+
+bool Image::writeImage( const std::string& filename,
+                        const Frame::Buffer buffer, const bool compress ) const
 {
     const Memory& memory = _impl->getMemory( buffer );
 
@@ -1244,35 +1700,20 @@ bool Image::writeImage( const std::string& filename,
     {
         convertedData = new unsigned char[nPixels*4];
 
-        const uint32_t* bgraData = reinterpret_cast< const uint32_t* >( data );
-        uint32_t* bgraConverted = reinterpret_cast< uint32_t* >( convertedData);
-        for( size_t i = 0; i < nPixels; ++i, ++bgraConverted, ++bgraData )
-        {
-            *bgraConverted = *bgraData;
-            uint32_t& pixel = *bgraConverted;
-            const uint32_t alpha = pixel >> 24;
-            if( alpha != 0 )
-            {
-                const uint32_t red = (pixel >> 16) & 0xff;
-                const uint32_t green = (pixel >> 8) & 0xff;
-                const uint32_t blue = pixel & 0xff;
-                *bgraConverted = (( alpha << 24 ) |
-                                 (((255 * red) / alpha ) << 16 ) |
-                                 (((255 * green) / alpha )  << 8 ) |
-                                 ((255 * blue) / alpha ));
-            }
-        }
+        unpremultiply( reinterpret_cast< const uint32_t* >( data ), nPixels,
+                       reinterpret_cast< uint32_t* >( convertedData ));
     }
 
     const bool retVal = _writeImage( filename, buffer,
-                                     convertedData ? convertedData : data );
+                                     convertedData ? convertedData : data,
+                                     compress );
     delete [] convertedData;
     return retVal;
 }
 
 bool Image::_writeImage( const std::string& filename,
                          const Frame::Buffer buffer,
-                         const unsigned char* data_ ) const
+                         const unsigned char* data_, const bool compress ) const
 {
     const Memory& memory = _impl->getMemory( buffer );
     const PixelViewport& pvp = memory.pvp;
@@ -1380,58 +1821,59 @@ bool Image::_writeImage( const std::string& filename,
         LBWARN << static_cast< int >( header.bytesPerChannel )
                << " bytes per channel not supported by RGB spec" << std::endl;
 
+    // Each channel is saved separately
+    std::vector< uint8_t > planes( nBytes );
+    planarize( data_, nPixels, nChannels, bpc, swapRB, planes.data( ));
+
+    const bool rle = compress && bpc == 1;
+    header.compression = rle ? 1 : 0;
     strncpy( header.filename, filename.c_str(), 80 );
     header.convert();
     image.write( reinterpret_cast<const char *>( &header ), sizeof( header ));
     header.convert();
 
-    const char* data = reinterpret_cast< const char* >( data_ );
-
-    // Each channel is saved separately
-    if( nChannels == 3 || nChannels == 4 )
+    if( rle )
     {
-        // channel one is R or B
-        if ( swapRB )
-            for( size_t j = 0 * bpc; j < nBytes; j += depth )
-                image.write( &data[j], bpc );
-        else
-            for( size_t j = 2 * bpc; j < nBytes; j += depth )
-                image.write( &data[j], bpc );
+        // one row per scanline and channel, tables are indexed the same way
+        const size_t nRows = size_t( pvp.h ) * nChannels;
+        const size_t maxSize = getMaxRLESize( pvp.w );
+        std::vector< uint8_t > rows( nRows * maxSize );
+        std::vector< uint32_t > starts( nRows );
+        std::vector< uint32_t > sizes( nRows );
 
-        // channel two is G
-        for( size_t j = 1 * bpc; j < nBytes; j += depth )
-            image.write( &data[j], bpc );
+#pragma omp parallel for
+        for( int32_t i = 0; i < int32_t( nRows ); ++i )
+            sizes[ i ] = uint32_t( encodeRLE( &planes[ i * pvp.w ], pvp.w,
+                                              &rows[ i * maxSize ] ));
 
-        // channel three is B or G
-        if ( swapRB )
-            for( size_t j = 2 * bpc; j < nBytes; j += depth )
-                image.write( &data[j], bpc );
-        else
-            for( size_t j = 0; j < nBytes; j += depth )
-                image.write( &data[j], bpc );
+        uint32_t offset = sizeof( header ) + 2 * nRows * sizeof( uint32_t );
+        for( size_t i = 0; i < nRows; ++i )
+        {
+            starts[ i ] = offset;
+            offset += sizes[ i ];
+        }
 
-        // channel four is Alpha
-        if( nChannels == 4 )
-            for( size_t j = 3 * bpc; j < nBytes; j += depth )
-                image.write( &data[j], bpc );
+        putBigEndian( image, starts );
+        putBigEndian( image, sizes );
+        for( size_t i = 0; i < nRows; ++i )
+            image.write( reinterpret_cast< const char* >( &rows[i * maxSize] ),
+                         sizes[ i ] );
     }
     else
-    {
-        for( size_t i = 0; i < nChannels; i += bpc )
-           for( size_t j = i * bpc; j < nBytes; j += depth )
-              image.write(&data[j], bpc );
-    }
+        image.write( reinterpret_cast< const char* >( planes.data( )), nBytes );
     image.close();
 
     if( header.bytesPerChannel == 1 )
         return true;
     // else also write 8bpp version
 
-    const std::string smallFilename = path.parent_path().string() + "/s_" +
+    const std::string& directory = path.parent_path().string();
+    const std::string smallFilename =
+        ( directory.empty() ? std::string() : directory + "/" ) + "s_" +
 #if BOOST_FILESYSTEM_VERSION == 3
-                                      path.filename().string();
+        path.filename().string();
 #else
-                                      path.filename();
+        path.filename();
 #endif
     image.open( smallFilename.c_str(), std::ios::out | std::ios::binary );
     if( !image.is_open( ))
@@ -1447,41 +1889,11 @@ bool Image::_writeImage( const std::string& filename,
     header.convert();
 
     LBASSERTINFO( bpc == 2 || bpc == 4, bpc );
-    const bool twoBPC = bpc == 2;
-
-    if( nChannels == 3 || nChannels == 4 )
-    {
-        // channel one is R or B
-        if ( swapRB )
-            for( size_t j = 0 * bpc; j < nBytes; j += depth )
-                twoBPC ? put16f( image, &data[j] ) : put32f( image, &data[j] );
-        else
-            for( size_t j = 2 * bpc; j < nBytes; j += depth )
-                twoBPC ? put16f( image, &data[j] ) : put32f( image, &data[j] );
-
-        // channel two is G
-        for( size_t j = 1 * bpc; j < nBytes; j += depth )
-                twoBPC ? put16f( image, &data[j] ) : put32f( image, &data[j] );
-
-        // channel three is B or G
-        if ( swapRB )
-            for( size_t j = 2 * bpc; j < nBytes; j += depth )
-                twoBPC ? put16f( image, &data[j] ) : put32f( image, &data[j] );
-        else
-            for( size_t j = 0; j < nBytes; j += depth )
-                twoBPC ? put16f( image, &data[j] ) : put32f( image, &data[j] );
-
-         // channel four is Alpha
-        if( nChannels == 4 )
-            for( size_t j = 3 * bpc; j < nBytes; j += depth )
-                twoBPC ? put16f( image, &data[j] ) : put32f( image, &data[j] );
-    }
-    else
-    {
-        for( size_t i = 0; i < nChannels; i += bpc )
-           for( size_t j = i * bpc; j < nBytes; j += depth )
-               twoBPC ? put16f( image, &data[j] ) : put32f( image, &data[j] );
-    }
+    const size_t nComponents = nPixels * nChannels;
+    std::vector< uint8_t > smallPlanes( nComponents );
+    toUnsignedByte( planes.data(), nComponents, bpc, smallPlanes.data( ));
+    image.write( reinterpret_cast< const char* >( smallPlanes.data( )),
+                 nComponents );
     image.close();
 
     return true;
@@ -1548,10 +1960,8 @@ bool Image::readImage( const std::string& filename, const Frame::Buffer buffer )
     }
 
     const uint8_t bpc = header.bytesPerChannel;
-    const size_t depth = nChannels * bpc;
     const size_t nPixels = header.width * header.height;
-    const size_t nComponents = nPixels * nChannels;
-    const size_t nBytes = nComponents * bpc;
+    const size_t nBytes = nPixels * nChannels * bpc;
 
     if( size < sizeof( RGBHeader ) + nBytes )
     {
@@ -1671,46 +2081,7 @@ bool Image::readImage( const std::string& filename, const Frame::Buffer buffer )
     LBASSERTINFO( nBytes <= getPixelDataSize( buffer ),
                   nBytes << " > " << getPixelDataSize( buffer ));
     // Each channel is saved separately
-    switch( bpc )
-    {
-    case 1:
-        for( size_t i = 0; i < nChannels; ++i )
-            for( size_t j = i; j < nComponents; j += nChannels )
-            {
-                data[j] = *addr;
-                ++addr;
-            }
-        break;
-
-    case 2:
-        for( size_t i = 0; i < nChannels; ++i )
-            for( size_t j = i; j < nComponents; j += nChannels )
-            {
-                reinterpret_cast< uint16_t* >( data )[ j ] =
-                    *reinterpret_cast< const uint16_t* >( addr );
-                addr += bpc;
-            }
-        break;
-
-    case 4:
-        for( size_t i = 0; i < nChannels; ++i )
-            for( size_t j = i; j < nComponents; j += nChannels )
-            {
-                reinterpret_cast< uint32_t* >( data )[ j ] =
-                    *reinterpret_cast< const uint32_t* >( addr );
-                addr += bpc;
-            }
-        break;
-
-    default:
-        for( size_t i = 0; i < depth; i += bpc )
-            for( size_t j = i * bpc; j < nBytes; j += depth )
-            {
-                memcpy( &data[j], addr, bpc );
-                addr += bpc;
-            }
-        break;
-    }
+    interleave( addr, nPixels, nChannels, bpc, true, data );
     return true;
 }
 
@@ -1780,6 +2151,16 @@ bool Image::getAlphaUsage() const
     return !_impl->ignoreAlpha;
 }
 
+void Image::setPremultipliedAlpha( const bool premultiplied )
+{
+    _impl->hasPremultipliedAlpha = premultiplied;
+}
+
+bool Image::hasPremultipliedAlpha() const
+{
+    return _impl->hasPremultipliedAlpha;
+}
+
 void Image::setOffset( int32_t x, int32_t y )
 {
     _impl->pvp.x = x;
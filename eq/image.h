@@ -24,6 +24,8 @@
 #include <eq/frame.h>         // for Frame::Buffer enum
 #include <eq/types.h>
 
+#include <vector>
+
 namespace eq
 {
 namespace detail { class Image; }
@@ -200,6 +202,15 @@ public:
     /** @return the pixel data, compressing it if needed. @version 1.0 */
     EQ_API const PixelData& compressPixelData( const Frame::Buffer );
 
+    /**
+     * Discard the compressed pixel data of the given buffer.
+     *
+     * The next compressPixelData() compresses the pixel data again, e.g., after
+     * it has been modified in place.
+     * @version 2.1
+     */
+    EQ_API void invalidateCompressedData( const Frame::Buffer buffer );
+
     /**
      * @return true if the image has valid pixel data for the buffer.
      * @version 1.0
@@ -221,7 +232,8 @@ public:
     /**
      * Clear and validate an image buffer.
      *
-     * RGBA and BGRA buffers are initialized with (0,0,0,255).
+     * RGBA and BGRA buffers are initialized with (0,0,0,255), the 10 bit,
+     * half float and float formats with black and full alpha.
      * DEPTH_UNSIGNED_INT buffers are initialized with 255. All other buffers
      * are zero-initialized. Validates the buffer.
      *
@@ -256,6 +268,16 @@ public:
     /** @return true if alpha data can not be ignored. @version 1.0 */
     EQ_API bool getAlphaUsage() const;
 
+    /**
+     * @internal
+     * Set if the color data is premultiplied by alpha, as after a readback
+     * with alpha. writeImage() un-premultiplies BGRA data before writing it.
+     */
+    EQ_API void setPremultipliedAlpha( bool premultiplied );
+
+    /** @internal @return true if the color data is premultiplied by alpha. */
+    EQ_API bool hasPremultipliedAlpha() const;
+
     /**
      * Set the minimum quality after a full download-compression path.
      *
@@ -275,6 +297,80 @@ public:
     EQ_API float getQuality( const Frame::Buffer buffer ) const;
     //@}
 
+    /** @name Coverage */
+    //@{
+    /** The number of pixels of a row represented by one coverage bit. */
+    static const int32_t COVERAGE_SEGMENT = 16;
+
+    /**
+     * A coverage bit mask, with one bit per segment of COVERAGE_SEGMENT
+     * pixels. The segments are ordered row by row, each row starting with a
+     * new segment.
+     */
+    typedef std::vector< uint64_t > CoverageMask;
+
+    /** @return true if the given segment is set in the mask. @version 2.1 */
+    static bool isCovered( const CoverageMask& mask, const size_t segment )
+        { return mask[ segment >> 6 ] & ( uint64_t( 1 ) << ( segment & 63 )); }
+
+    /**
+     * Compute the coverage mask from the depth buffer.
+     *
+     * A segment is covered if one of its depth values is not on the far plane.
+     * Only unsigned int depth buffers in main memory are supported.
+     *
+     * @return the ratio of covered segments, or 1 if the depth buffer is not
+     *         supported.
+     * @version 2.1
+     */
+    EQ_API float updateCoverage();
+
+    /**
+     * @return the coverage mask of the image, empty if unknown. The mask is
+     *         reset when the depth buffer or the pixel viewport changes.
+     * @version 2.1
+     */
+    EQ_API const CoverageMask& getCoverage() const;
+
+    /**
+     * @return the ratio of covered segments of the coverage mask, or 1 if the
+     *         coverage is unknown.
+     * @version 2.1
+     */
+    EQ_API float getCoverageRatio() const;
+
+    /**
+     * Pack the covered segments of a buffer into a single row.
+     *
+     * The given image receives the pixels of all covered segments, in order,
+     * using the format of this image. The coverage has to be computed using
+     * updateCoverage().
+     *
+     * @param buffer the buffer to pack.
+     * @param packed the image receiving the packed pixels.
+     * @return false if no segment is covered, true otherwise.
+     * @version 2.1
+     */
+    EQ_API bool packPixelData( const Frame::Buffer buffer,
+                               Image& packed ) const;
+
+    /**
+     * Set the pixel data of a buffer from a packed image.
+     *
+     * The covered segments are copied from the packed image, all other pixels
+     * are cleared as in clearPixelData(). The given mask becomes the coverage
+     * of this image.
+     *
+     * @param buffer the buffer to unpack.
+     * @param packed the packed pixels, as created by packPixelData().
+     * @param mask the coverage mask used to pack the pixels.
+     * @version 2.1
+     */
+    EQ_API void unpackPixelData( const Frame::Buffer buffer,
+                                 const Image& packed,
+                                 const CoverageMask& mask );
+    //@}
+
     /** @name Texture Data Access */
     //@{
     /** Get the texture of this image. @version 1.0 */
@@ -348,6 +444,21 @@ public:
     EQ_API bool writeImage( const std::string& filename,
                             const Frame::Buffer buffer ) const;
 
+    /**
+     * Write the pixel data as rgb image file, optionally compressed.
+     *
+     * Run-length encoding is only applied to images with one byte per
+     * channel, other images and non-rgb files are written as above.
+     *
+     * @param filename the output file name.
+     * @param buffer the image buffer to write.
+     * @param compress true to use run-length encoding, false for raw data.
+     * @return true on success, false on error.
+     * @version 2.1
+     */
+    EQ_API bool writeImage( const std::string& filename,
+                            const Frame::Buffer buffer, bool compress ) const;
+
     /** Write all valid pixel data as separate images. @version 1.0 */
     EQ_API bool writeImages( const std::string& filenameTemplate ) const;
 
@@ -428,7 +539,7 @@ private:
     void _finishReadback( const Frame::Buffer buffer, const GLEWContext* );
     bool _readbackZoom( const Frame::Buffer buffer, util::ObjectManager& om );
     bool _writeImage( const std::string& filename, const Frame::Buffer buffer,
-                      const unsigned char* data ) const;
+                      const unsigned char* data, bool compress ) const;
 };
 
 /** eq::Image serializer. @version 2.1 */
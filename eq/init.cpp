@@ -26,6 +26,7 @@
 
 #include "client.h"
 #include "config.h"
+#include "cpu/windowSystem.h"
 #include "global.h"
 #include "nodeFactory.h"
 #include "os.h"
@@ -130,6 +131,8 @@ bool _init( const int argc, char** argv, NodeFactory* nodeFactory )
     if( QApplication::instance( ))
         WindowSystem::add( WindowSystemImpl( new qt::WindowSystem ));
 #endif
+    // last, never chosen as the default window system
+    WindowSystem::add( WindowSystemImpl( new cpu::WindowSystem ));
 
     LBASSERT( nodeFactory );
     Global::_nodeFactory = nodeFactory;
@@ -21,6 +21,7 @@
 
 #include "client.h"
 #include "config.h"
+#include "disseminationBarrier.h"
 #include "error.h"
 #include "exception.h"
 #include "frameData.h"
@@ -110,6 +111,9 @@ public:
     /** All frame datas used by the node during rendering. */
     lunchbox::Lockable< FrameDataHash > frameDatas;
 
+    /** The dissemination barriers entered by the node's windows. */
+    DisseminationBarrier disseminationBarrier;
+
     TransmitThread transmitter;
 };
 
@@ -162,6 +166,8 @@ void Node::attach( const uint128_t& id, const uint32_t instanceID )
                      NodeFunc( this, &Node::_cmdFrameDataTransmit ), commandQ );
     registerCommand( fabric::CMD_NODE_FRAMEDATA_READY,
                      NodeFunc( this, &Node::_cmdFrameDataReady ), commandQ );
+    registerCommand( fabric::CMD_NODE_BARRIER_SIGNAL,
+                     NodeFunc( this, &Node::_cmdBarrierSignal ), commandQ );
 }
 
 void Node::setDirty( const uint64_t bits )
@@ -235,6 +241,16 @@ co::Barrier* Node::getBarrier( const co::ObjectVersion& barrier )
     return netBarrier;
 }
 
+bool Node::enterBarrier( const uint128_t& barrier, const uint32_t rank,
+                         const std::vector< uint128_t >& nodes,
+                         const co::NodeIDs& netNodes,
+                         const std::vector< uint32_t >& ranks,
+                         const uint32_t timeout )
+{
+    return _impl->disseminationBarrier.enter( getLocalNode(), barrier, rank,
+                                              nodes, netNodes, ranks, timeout );
+}
+
 FrameDataPtr Node::getFrameData( const co::ObjectVersion& frameDataVersion )
 {
     lunchbox::ScopedWrite mutex( _impl->frameDatas );
@@ -492,7 +508,7 @@ bool Node::processEvent( Statistic& event )
 {
     Config* config = getConfig();
     updateEvent( event, config->getTime( ));
-    config->sendEvent( EVENT_STATISTIC ) << event;
+    config->sendStatistic( event );
     return true;
 }
 
@@ -508,6 +524,7 @@ void Node::_flushObjects()
         }
         _impl->barriers->clear();
     }
+    _impl->disseminationBarrier.clear();
 
     lunchbox::ScopedWrite mutex( _impl->frameDatas );
     for( FrameDataHashCIter i = _impl->frameDatas->begin();
@@ -637,6 +654,7 @@ bool Node::_cmdConfigExit( co::ICommand& cmd )
     }
 
     _impl->state = configExit() ? STATE_STOPPED : STATE_FAILED;
+    getConfig()->flushStatistics();
     getTransmitterQueue()->push( co::ICommand( )); // wake up to exit
     _impl->transmitter.join();
     _flushObjects();
@@ -692,6 +710,7 @@ bool Node::_cmdFrameFinish( co::ICommand& cmd )
 
     _finishFrame( frameNumber );
     _frameFinish( frameID, frameNumber );
+    getConfig()->flushStatistics();
 
     const uint128_t version = commit();
     if( version != co::VERSION_NONE )
@@ -738,6 +757,7 @@ bool Node::_cmdFrameDataTransmit( co::ICommand& cmd )
     const Frame::Buffer buffers = command.read< Frame::Buffer >();
     const uint32_t frameNumber = command.read< uint32_t >();
     const bool useAlpha = command.read< bool >();
+    const bool packed = command.read< bool >();
     const uint8_t* data = reinterpret_cast< const uint8_t* >(
                 command.getRemainingBuffer( command.getRemainingBufferSize( )));
 
@@ -757,7 +777,8 @@ bool Node::_cmdFrameDataTransmit( co::ICommand& cmd )
     // pointers, we have to go non-const at some point, even though we do not
     // modify the data.
     LBCHECK( frameData->addImage( frameDataVersion, pvp, zoom, context, buffers,
-                                  useAlpha, const_cast< uint8_t* >( data )));
+                                  useAlpha, packed,
+                                  const_cast< uint8_t* >( data )));
     return true;
 }
 
@@ -780,6 +801,19 @@ bool Node::_cmdFrameDataReady( co::ICommand& cmd )
     return true;
 }
 
+bool Node::_cmdBarrierSignal( co::ICommand& cmd )
+{
+    co::ObjectICommand command( cmd );
+    const uint128_t& barrier = command.read< uint128_t >();
+    const uint32_t rank = command.read< uint32_t >();
+    const uint32_t round = command.read< uint32_t >();
+
+    LBLOG( co::LOG_BARRIER ) << "received round " << round << " for rank "
+                             << rank << " of barrier " << barrier << std::endl;
+    _impl->disseminationBarrier.signal( barrier, rank, round );
+    return true;
+}
+
 bool Node::_cmdSetAffinity( co::ICommand& cmd )
 {
     co::ObjectICommand command( cmd );
@@ -77,6 +77,27 @@ public:
      */
     co::Barrier* getBarrier( const co::ObjectVersion& barrier );
 
+    /**
+     * @internal
+     * Enter a dissemination barrier.
+     *
+     * In round k, the participant signals the given peer k and waits for the
+     * signal of round k from its predecessor.
+     *
+     * @param barrier the unique identifier of the barrier.
+     * @param rank the rank of the entering participant.
+     * @param nodes the node to signal in each round.
+     * @param netNodes the network node of each node.
+     * @param ranks the rank to signal in each round.
+     * @param timeout the maximum time to wait, in milliseconds.
+     * @return true if all rounds completed, false on timeout or error.
+     */
+    bool enterBarrier( const uint128_t& barrier, uint32_t rank,
+                       const std::vector< uint128_t >& nodes,
+                       const co::NodeIDs& netNodes,
+                       const std::vector< uint32_t >& ranks,
+                       uint32_t timeout );
+
     /**
      * @internal
      * Get a frame data instance.
@@ -285,6 +306,7 @@ private:
     bool _cmdFrameTasksFinish( co::ICommand& command );
     bool _cmdFrameDataTransmit( co::ICommand& command );
     bool _cmdFrameDataReady( co::ICommand& command );
+    bool _cmdBarrierSignal( co::ICommand& command );
     bool _cmdSetAffinity( co::ICommand& command );
 
     LB_TS_VAR( _nodeThread );
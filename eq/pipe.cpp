@@ -901,7 +901,7 @@ bool Pipe::processEvent( Statistic& event )
 {
     Config* config = getConfig();
     updateEvent( event, config->getTime( ));
-    config->sendEvent( EVENT_STATISTIC ) << event;
+    config->sendStatistic( event );
     return true;
 }
 
@@ -87,6 +87,7 @@ Channel::Channel( Window* parent )
         , _segment( 0 )
         , _state( STATE_STOPPED )
         , _lastDrawCompound( 0 )
+        , _updateFrame( 0 )
         , _private( 0 )
 {
     const Global* global = Global::instance();
@@ -109,6 +110,7 @@ Channel::Channel( const Channel& from )
         , _segment( 0 )
         , _state( STATE_STOPPED )
         , _lastDrawCompound( 0 )
+        , _updateFrame( 0 )
         , _private( 0 )
 {
     // Don't copy view and segment. Will be re-set by segment copy ctor
@@ -202,6 +204,17 @@ const Compounds& Channel::getCompounds() const
     return getConfig()->getCompounds();
 }
 
+void Channel::addUpdateCompound( Compound* root, const uint32_t frameNumber )
+{
+    if( _updateFrame != frameNumber )
+    {
+        _updateCompounds.clear();
+        _updateFrame = frameNumber;
+    }
+    if( _updateCompounds.empty() || _updateCompounds.back() != root )
+        _updateCompounds.push_back( root );
+}
+
 co::CommandQueue* Channel::getMainThreadQueue()
 {
     Window* window = getWindow();
@@ -387,7 +400,9 @@ bool Channel::update( const uint128_t& frameID, const uint32_t frameNumber )
                        << frameNumber << std::endl;
 
     bool updated = false;
-    const Compounds& compounds = getCompounds();
+    // fall back to all compounds if this channel is not used by any
+    const Compounds& compounds = _updateFrame == frameNumber ?
+                                     _updateCompounds : getCompounds();
     for( Compounds::const_iterator i = compounds.begin();
          i != compounds.end(); ++i )
     {
@@ -439,9 +454,9 @@ void Channel::removeListener(  ChannelListener* listener )
         _listeners.erase( i );
 }
 
-void Channel::_fireLoadData( const uint32_t frameNumber,
-                             const fabric::Statistics& statistics,
-                             const Viewport& region )
+void Channel::fireLoadData( const uint32_t frameNumber,
+                            const fabric::Statistics& statistics,
+                            const Viewport& region )
 {
     LB_TS_SCOPED( _serverThread );
     for( ChannelListener* listener : _listeners )
@@ -478,9 +493,10 @@ bool Channel::_cmdFrameFinishReply( co::ICommand& cmd )
     co::ObjectICommand command( cmd );
     const Viewport& region = command.read< Viewport >();
     const uint32_t frameNumber = command.read< uint32_t >();
-    const Statistics& statistics = command.read< Statistics >();
+    Statistics statistics;
+    fabric::deserializeStatistics( command, statistics );
 
-    _fireLoadData( frameNumber, statistics, region );
+    fireLoadData( frameNumber, statistics, region );
     return true;
 }
 
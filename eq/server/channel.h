@@ -130,6 +130,14 @@ public:
         { _lastDrawCompound = compound; }
     const Compound* getLastDrawCompound() const { return _lastDrawCompound;}
 
+    /**
+     * Add a root compound using this channel in the given frame.
+     *
+     * update() only traverses the compound trees using this channel, instead
+     * of all compounds of the config.
+     */
+    void addUpdateCompound( Compound* root, const uint32_t frameNumber );
+
     void setIAttribute( const IAttribute attr, const int32_t value )
         { fabric::Channel< Window, Channel >::setIAttribute( attr, value );}
     void setSAttribute( const SAttribute attr, const std::string& value )
@@ -173,6 +181,10 @@ public:
     void removeListener( ChannelListener* listener );
     /** @return true if the channel has listeners */
     bool hasListeners() const { return !_listeners.empty(); }
+
+    /** @internal Notify all listeners of the load data of a frame. */
+    void fireLoadData( const uint32_t frameNumber,
+                       const Statistics& statistics, const Viewport& region );
     //@}
 
     bool omitOutput() const; //!< @internal
@@ -201,6 +213,10 @@ private:
     /** The last draw compound for this entity */
     const Compound* _lastDrawCompound;
 
+    /** The root compounds using this channel in _updateFrame */
+    Compounds _updateCompounds;
+    uint32_t _updateFrame;
+
     typedef std::vector< ChannelListener* > ChannelListeners;
     ChannelListeners _listeners;
 
@@ -215,10 +231,6 @@ private:
     void _setupRenderContext( const uint128_t& frameID,
                               RenderContext& context );
 
-    void _fireLoadData( const uint32_t frameNumber,
-                        const Statistics& statistics,
-                        const Viewport& region );
-
     /* command handler functions. */
     bool _cmdConfigInitReply( co::ICommand& command );
     bool _cmdConfigExitReply( co::ICommand& command );
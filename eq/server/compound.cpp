@@ -38,10 +38,12 @@
 #include "segment.h"
 #include "view.h"
 #include "observer.h"
+#include "window.h"
 
 #include <eq/fabric/paths.h>
 #include <lunchbox/algorithm.h>
 #include <lunchbox/os.h>
+#include <servus/uint128_t.h>
 #include <boost/foreach.hpp>
 
 #include <algorithm>
@@ -1162,6 +1164,40 @@ void Compound::restore()
 //---------------------------------------------------------------------------
 // pre-render compound state update
 //---------------------------------------------------------------------------
+namespace
+{
+// Swap barriers with more windows use a dissemination barrier
+static const uint32_t DISSEMINATION_HEIGHT = 8;
+
+bool _disseminate( const co::Barrier* barrier,
+                   const Compound::BarrierWindowsMap& swapWindows,
+                   const std::string& name )
+{
+    Compound::BarrierWindowsMap::const_iterator i = swapWindows.find( name );
+    if( i == swapWindows.end( ))
+        return false; // NV_swap_group protection barrier
+
+    Windows participants;
+    for( Window* window : i->second )
+    {
+        if( !window->hasSwapBarrier( barrier ))
+            continue; // another window of the pipe enters for it
+        if( window->hasNVSwapBarrier( ))
+            return false; // NV_swap_group entry needs the net::Barrier
+        participants.push_back( window );
+    }
+
+    if( participants.size() != barrier->getHeight( ))
+        return false;
+
+    const uint128_t id = servus::make_UUID();
+    for( size_t i = 0; i < participants.size(); ++i )
+        participants[i]->joinDisseminationBarrier( barrier, id, participants,
+                                                   uint32_t( i ));
+    return true;
+}
+}
+
 void Compound::update( const uint32_t frameNumber )
 {
     // https://github.com/Eyescale/Equalizer/issues/76
@@ -1187,10 +1223,17 @@ void Compound::update( const uint32_t frameNumber )
     }
 
     const BarrierMap& swapBarriers = updateOutputVisitor.getSwapBarriers();
+    const BarrierWindowsMap& swapWindows =
+        updateOutputVisitor.getSwapBarrierWindows();
     for( BarrierMapCIter i = swapBarriers.begin(); i != swapBarriers.end(); ++i)
     {
         co::Barrier* barrier = i->second;
         LBASSERT( barrier->isGood( ));
+        if( barrier->getHeight() >= DISSEMINATION_HEIGHT &&
+            _disseminate( barrier, swapWindows, i->first ))
+        {
+            continue;
+        }
         if( barrier->getHeight() > 1 )
             barrier->commit();
     }
@@ -478,10 +478,14 @@ public:
 
     /** @name Compound listener interface. */
     //@{
+    typedef std::vector< CompoundListener* > CompoundListeners;
+
     /** Register a compound listener. */
     void addListener( CompoundListener* listener );
     /** Deregister a compound listener. */
     void removeListener( CompoundListener* listener );
+    /** @return the registered compound listeners, e.g., the equalizers. */
+    const CompoundListeners& getListeners() const { return _listeners; }
 
     /** Notify all listeners that the compound is about to be updated. */
     void fireUpdatePre( const uint32_t frameNumber );
@@ -500,6 +504,7 @@ public:
 
     typedef std::unordered_map<std::string, co::Barrier*> BarrierMap;
     typedef BarrierMap::const_iterator BarrierMapCIter;
+    typedef std::unordered_map<std::string, Windows> BarrierWindowsMap;
 
     typedef std::unordered_map<std::string, Frame*> FrameMap;
     typedef FrameMap::const_iterator FrameMapCIter;
@@ -563,7 +568,6 @@ private:
     /** The frustum description of this compound. */
     Frustum _frustum;
 
-    typedef std::vector< CompoundListener* > CompoundListeners;
     CompoundListeners _listeners;
 
     Equalizers _equalizers;
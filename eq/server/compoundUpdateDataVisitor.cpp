@@ -35,6 +35,10 @@ VisitorResult CompoundUpdateDataVisitor::visit( Compound* compound )
     compound->fireUpdatePre( _frameNumber );
     compound->updateInheritData( _frameNumber );
 
+    Channel* channel = compound->getChannel();
+    if( channel )
+        channel->addUpdateCompound( compound->getRoot(), _frameNumber );
+
     _updateDrawFinish( compound );
     return TRAVERSE_CONTINUE;
 }
@@ -31,6 +31,8 @@
 #include <eq/fabric/iAttribute.h>
 #include <eq/fabric/tile.h>
 
+#include <algorithm>
+
 namespace eq
 {
 namespace server
@@ -308,6 +310,13 @@ void CompoundUpdateOutputVisitor::_updateSwapBarriers( Compound* compound )
     {
         const std::string& name = swapBarrier->getName();
         _swapBarriers[name] = window->joinSwapBarrier( _swapBarriers[name] );
+
+        Windows& windows = _swapBarrierWindows[name];
+        if( std::find( windows.begin(), windows.end(), window ) ==
+            windows.end( ))
+        {
+            windows.push_back( window );
+        }
     }
 }
 
@@ -41,6 +41,9 @@ public:
 
     const Compound::BarrierMap& getSwapBarriers() const
         { return _swapBarriers; }
+    /** @return the windows which joined each swap barrier, by name. */
+    const Compound::BarrierWindowsMap& getSwapBarrierWindows() const
+        { return _swapBarrierWindows; }
     const Compound::FrameMap& getOutputFrames() const
         { return _outputFrames; }
     const Compound::TileQueueMap& getOutputQueues() const
@@ -50,6 +53,7 @@ private:
     const uint32_t _frameNumber;
 
     Compound::BarrierMap   _swapBarriers;
+    Compound::BarrierWindowsMap _swapBarrierWindows;
     Compound::FrameMap     _outputFrames;
     Compound::TileQueueMap _outputTileQueues;
 
@@ -0,0 +1,324 @@
+/* Copyright (c) 2016, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "configSimulator.h"
+
+#include "canvas.h"
+#include "channel.h"
+#include "compound.h"
+#include "compoundListener.h"
+#include "config.h"
+#include "configUpdateDataVisitor.h"
+#include "layout.h"
+#include "node.h"
+#include "observer.h"
+#include "pipe.h"
+#include "server.h"
+#include "view.h"
+#include "window.h"
+
+#include <eq/fabric/statistic.h>
+#include <co/bufferConnection.h>
+#include <lunchbox/clock.h>
+
+#include <algorithm>
+
+namespace eq
+{
+namespace server
+{
+namespace
+{
+// simulated draw time of one pixel at speed 1, in ms
+static const double DRAW_TIME = 0.0001;
+
+typedef std::map< Channel*, Compounds > DrawMap;
+
+/**
+ * Collects the compounds drawing on each channel in the current frame. All
+ * channels with tasks are collected, since they all report their load.
+ */
+class DrawVisitor : public CompoundVisitor
+{
+public:
+    explicit DrawVisitor( DrawMap& draws ) : _draws( draws ) {}
+
+    VisitorResult visit( Compound* compound ) override
+    {
+        Channel* channel = compound->getChannel();
+        if( !channel || !compound->isActive() ||
+            compound->getInheritTasks() == fabric::TASK_NONE )
+        {
+            return TRAVERSE_CONTINUE;
+        }
+
+        Compounds& draws = _draws[ channel ];
+        if( compound->testInheritTask( fabric::TASK_DRAW ) &&
+            compound->getInheritPixelViewport().hasArea( ))
+        {
+            draws.push_back( compound );
+        }
+        return TRAVERSE_CONTINUE;
+    }
+
+private:
+    DrawMap& _draws;
+};
+
+/** Measures the update of a compound listener, i.e., an equalizer */
+class ListenerTimer : public CompoundListener
+{
+public:
+    ListenerTimer( CompoundListener* listener_, float& time )
+        : listener( listener_ ), _time( time ) {}
+
+    void notifyUpdatePre( Compound* compound,
+                          const uint32_t frameNumber ) override
+    {
+        _clock.reset();
+        listener->notifyUpdatePre( compound, frameNumber );
+        _time += _clock.getTimef();
+    }
+
+    void notifyChildAdded( Compound* compound, Compound* child ) override
+        { listener->notifyChildAdded( compound, child ); }
+
+    void notifyChildRemove( Compound* compound, Compound* child ) override
+        { listener->notifyChildRemove( compound, child ); }
+
+    CompoundListener* const listener;
+
+private:
+    float& _time;
+    lunchbox::Clock _clock;
+};
+
+typedef std::vector< std::pair< Compound*, CompoundListener* > > Timers;
+
+/** Replaces all compound listeners by a timer, keeping their order */
+class TimerVisitor : public CompoundVisitor
+{
+public:
+    TimerVisitor( Timers& timers, float& time )
+        : _timers( timers ), _time( time ) {}
+
+    VisitorResult visit( Compound* compound ) override
+    {
+        // copy, the listeners of the compound are replaced below
+        const Compound::CompoundListeners listeners =
+            compound->getListeners();
+        for( CompoundListener* listener : listeners )
+        {
+            ListenerTimer* timer = new ListenerTimer( listener, _time );
+            compound->removeListener( listener );
+            compound->addListener( timer );
+            _timers.push_back( std::make_pair( compound, timer ));
+        }
+        return TRAVERSE_CONTINUE;
+    }
+
+private:
+    Timers& _timers;
+    float& _time;
+};
+
+template< class T > void _setState( const std::vector< T* >& entities,
+                                    const State state )
+{
+    // only active resources are started, see Config::_updateRunning
+    for( T* entity : entities )
+        if( state != STATE_RUNNING || entity->isActive( ))
+            entity->setState( state );
+}
+}
+
+ConfigSimulator::ConfigSimulator( Config& config )
+    : _config( config )
+    , _listening( false )
+    , _registered( false )
+    , _frameNumber( 0 )
+{
+    // see Server::init, frames and tile queues are distributed objects
+    ServerPtr server = config.getServer();
+    if( server->isClosed( ))
+    {
+        LBCHECK( server->listen( ));
+        _listening = true;
+    }
+    if( !config.isAttached( ))
+    {
+        config.register_();
+        _registered = true;
+    }
+
+    // see Config::_init
+    for( Compound* compound : config.getCompounds( ))
+        compound->init();
+
+    for( Observer* observer : config.getObservers( ))
+        observer->init();
+
+    for( Canvas* canvas : config.getCanvases( ))
+        canvas->init();
+
+    for( Layout* layout : config.getLayouts( ))
+        for( View* view : layout->getViews( ))
+            view->init();
+
+    // stub render clients: all resources initialized successfully, all tasks
+    // are sent to a buffer instead of a render client
+    const Nodes& nodes = config.getNodes();
+    _setState( nodes, STATE_RUNNING );
+    for( Node* node : nodes )
+    {
+        co::BufferConnectionPtr connection = new co::BufferConnection;
+        node->setTaskConnection( connection );
+        _connections.push_back( connection );
+
+        const Pipes& pipes = node->getPipes();
+        _setState( pipes, STATE_RUNNING );
+        for( const Pipe* pipe : pipes )
+        {
+            const Windows& windows = pipe->getWindows();
+            _setState( windows, STATE_RUNNING );
+            for( const Window* window : windows )
+                _setState( window->getChannels(), STATE_RUNNING );
+        }
+    }
+
+    // Needed to set up active state for first LB update
+    for( Compound* compound : config.getCompounds( ))
+        compound->update( 0 );
+
+    // time the equalizers, which are the compound listeners
+    TimerVisitor timerVisitor( _timers, _stats.equalizerTime );
+    for( Compound* compound : config.getCompounds( ))
+        compound->accept( timerVisitor );
+}
+
+ConfigSimulator::~ConfigSimulator()
+{
+    for( const auto& i : _timers )
+    {
+        ListenerTimer* timer = static_cast< ListenerTimer* >( i.second );
+        i.first->removeListener( timer );
+        i.first->addListener( timer->listener );
+        delete timer;
+    }
+    _timers.clear();
+
+    for( Canvas* canvas : _config.getCanvases( ))
+        canvas->exit();
+
+    for( Compound* compound : _config.getCompounds( ))
+        compound->exit();
+
+    const Nodes& nodes = _config.getNodes();
+    _setState( nodes, STATE_STOPPED );
+    for( Node* node : nodes )
+    {
+        node->setTaskConnection( 0 );
+        const Pipes& pipes = node->getPipes();
+        _setState( pipes, STATE_STOPPED );
+        for( const Pipe* pipe : pipes )
+        {
+            const Windows& windows = pipe->getWindows();
+            _setState( windows, STATE_STOPPED );
+            for( const Window* window : windows )
+                _setState( window->getChannels(), STATE_STOPPED );
+        }
+    }
+
+    if( _registered )
+        _config.deregister();
+    if( _listening )
+        _config.getServer()->close();
+}
+
+void ConfigSimulator::setSpeed( const Node* node, const float speed )
+{
+    _speeds[ node ] = speed;
+}
+
+const ConfigSimulator::Stats& ConfigSimulator::frame()
+{
+    const uint32_t frameNumber = ++_frameNumber;
+    const uint128_t frameID( frameNumber );
+    _stats = Stats();
+
+    // see Config::_startFrame
+    lunchbox::Clock clock;
+    for( Compound* compound : _config.getCompounds( ))
+        compound->update( frameNumber );
+    ConfigUpdateDataVisitor configDataVisitor;
+    _config.accept( configDataVisitor );
+    _stats.updateTime = clock.resetTimef() - _stats.equalizerTime;
+
+    const Nodes& nodes = _config.getNodes();
+    uint64_t nTasks = 0;
+    for( const Node* node : nodes )
+        nTasks += node->getNumTasks();
+
+    for( Node* node : nodes )
+        node->update( frameID, frameNumber );
+    _stats.taskTime = clock.resetTimef();
+
+    for( const Node* node : nodes )
+        _stats.nTasks += node->getNumTasks();
+    _stats.nTasks -= nTasks;
+
+    for( co::BufferConnectionPtr connection : _connections )
+    {
+        lunchbox::Bufferb& buffer = connection->getBuffer();
+        _stats.nBytes += buffer.getSize();
+        buffer.setSize( 0 );
+    }
+
+    // stub render clients: report frame finish
+    DrawMap draws;
+    DrawVisitor drawVisitor( draws );
+    for( Compound* compound : _config.getCompounds( ))
+        compound->accept( drawVisitor );
+
+    for( DrawMap::const_iterator i = draws.begin(); i != draws.end(); ++i )
+    {
+        Channel* channel = i->first;
+        const Node* node = channel->getNode();
+        const std::map< const Node*, float >::const_iterator j =
+            _speeds.find( node );
+        const double speed = j == _speeds.end() ? 1.0 : j->second;
+
+        Statistics statistics;
+        for( const Compound* compound : i->second )
+        {
+            const PixelViewport& pvp = compound->getInheritPixelViewport();
+            const double time = double( pvp.getArea( )) * DRAW_TIME / speed;
+
+            Statistic stat = Statistic();
+            stat.type = Statistic::CHANNEL_DRAW;
+            stat.frameNumber = frameNumber;
+            stat.task = compound->getTaskID();
+            stat.startTime = 0;
+            stat.endTime = std::max( int64_t( time + .5 ), int64_t( 1 ));
+            statistics.push_back( stat );
+        }
+        channel->fireLoadData( frameNumber, statistics, Viewport::FULL );
+    }
+    return _stats;
+}
+
+}
+}
@@ -0,0 +1,97 @@
+/* Copyright (c) 2016, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQSERVER_CONFIGSIMULATOR_H
+#define EQSERVER_CONFIGSIMULATOR_H
+
+#include <eq/server/api.h>
+#include "types.h"
+
+#include <co/types.h>
+#include <boost/noncopyable.hpp>
+#include <map>
+#include <vector>
+
+namespace eq
+{
+namespace server
+{
+/**
+ * Runs the server-side frame update of a config without render clients.
+ *
+ * The server listens locally and all objects of the config are registered.
+ * All resources of the config are set running as if their render clients had
+ * initialized successfully. Each frame updates all compounds using
+ * Compound::update() and generates the tasks of all nodes using
+ * Node::update(), which sends them to a buffer instead of the render client.
+ * The stub clients then report synthetic load data, where the draw time of a
+ * channel is proportional to its rendered pixels divided by the speed of its
+ * node.
+ *
+ * Used for headless benchmarks and tests of the compound and equalizer code.
+ */
+class ConfigSimulator : public boost::noncopyable
+{
+public:
+    /** Per-frame timings in milliseconds and task statistics. */
+    struct Stats
+    {
+        Stats() : equalizerTime( 0.f ), updateTime( 0.f ), taskTime( 0.f )
+                , nTasks( 0 ), nBytes( 0 )
+        {}
+
+        float equalizerTime; //!< Equalizer updates of the compound update
+        float updateTime;    //!< Compound update, excluding the equalizers
+        float taskTime;      //!< Node task generation
+        uint64_t nTasks;     //!< Number of task commands generated
+        uint64_t nBytes;     //!< Size of all task commands
+    };
+
+    /** Initialize all compounds and channels of the given stopped config. */
+    EQSERVER_API explicit ConfigSimulator( Config& config );
+
+    /** Deactivate all compounds and deregister the config. */
+    EQSERVER_API ~ConfigSimulator();
+
+    /**
+     * Set the speed of all stub clients on the given node.
+     *
+     * @param node the node.
+     * @param speed the relative speed, 1 by default.
+     */
+    EQSERVER_API void setSpeed( const Node* node, float speed );
+
+    /** Update and simulate one frame. @return the frame statistics. */
+    EQSERVER_API const Stats& frame();
+
+    /** @return the number of the last simulated frame. */
+    uint32_t getFrameNumber() const { return _frameNumber; }
+
+private:
+    Config& _config;
+
+    /** Timers replacing the compound listeners, with their compound */
+    std::vector< std::pair< Compound*, CompoundListener* > > _timers;
+    bool _listening; //!< The server was started by the simulator
+    bool _registered; //!< The config was registered by the simulator
+    std::vector< co::BufferConnectionPtr > _connections;
+    std::map< const Node*, float > _speeds;
+    uint32_t _frameNumber;
+    Stats _stats;
+};
+}
+}
+#endif // EQSERVER_CONFIGSIMULATOR_H
@@ -0,0 +1,307 @@
+/* Copyright (c) 2016, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "budgetEqualizer.h"
+
+#include "../compound.h"
+#include "../compoundVisitor.h"
+#include "../config.h"
+#include "../log.h"
+
+#include <eq/fabric/statistic.h>
+#include <eq/fabric/zoom.h>
+#include <lunchbox/debug.h>
+
+#include <cmath>
+#include <limits>
+
+namespace eq
+{
+namespace server
+{
+namespace
+{
+static const size_t NSAMPLES = 4;       // frames averaged per decision
+static const size_t MAXFRAMES = 16;     // frames awaiting load data
+static const float IMBALANCE = 1.25f;   // max/avg channel time to rebalance
+static const float MINZOOM = .25f;      // lower bound of resolution drop
+static const float SLOWDOWN = 1.05f;    // throttle slightly below budget
+
+class LoadSubscriber : public CompoundVisitor
+{
+public:
+    explicit LoadSubscriber( const BudgetEqualizer* equalizer )
+        : _equalizer( equalizer ) {}
+
+    VisitorResult visit( Compound* compound ) override
+    {
+        if( compound != _equalizer->getCompound( ))
+        {
+            const Equalizers& equalizers = compound->getEqualizers();
+            for( const Equalizer* equalizer : equalizers )
+            {
+                const uint32_t type = equalizer->getType();
+                if( type == fabric::DFR_EQUALIZER ||
+                    type == fabric::FRAMERATE_EQUALIZER )
+                {
+                    LBWARN << "Budget equalizer and DFR or framerate "
+                           << "equalizer used in the same compound tree"
+                           << std::endl;
+                }
+            }
+        }
+        if( compound->getChannel( ))
+            _compounds.push_back( compound );
+        return TRAVERSE_CONTINUE;
+    }
+
+    Compounds _compounds;
+
+private:
+    const BudgetEqualizer* const _equalizer;
+};
+}
+
+BudgetEqualizer::BudgetEqualizer()
+        : _zoom( 1.f )
+{
+    LBINFO << "New BudgetEqualizer @" << (void*)this << std::endl;
+}
+
+BudgetEqualizer::~BudgetEqualizer()
+{
+    attach( 0 );
+    LBINFO << "Delete BudgetEqualizer @" << (void*)this << std::endl;
+}
+
+void BudgetEqualizer::attach( Compound* compound )
+{
+    _exit();
+    Equalizer::attach( compound );
+}
+
+void BudgetEqualizer::_init()
+{
+    Compound* compound = getCompound();
+    if( !_listeners.empty() || !compound )
+        return;
+
+    LoadSubscriber subscriber( this );
+    compound->accept( subscriber );
+
+    // A channel reports its load once per frame for all its compounds
+    for( Compound* child : subscriber._compounds )
+    {
+        Channel* channel = child->getChannel();
+        std::deque< LoadListener >::iterator i = _listeners.begin();
+        while( i != _listeners.end() && i->channel != channel )
+            ++i;
+        if( i == _listeners.end( ))
+        {
+            _listeners.push_back( LoadListener( ));
+            i = _listeners.end() - 1;
+            i->parent = this;
+            i->channel = channel;
+            i->period = child->getInheritPeriod();
+        }
+        i->compounds.push_back( child );
+        i->period = LB_MIN( i->period, child->getInheritPeriod( ));
+    }
+
+    for( LoadListener& listener : _listeners )
+        listener.channel->addListener( &listener );
+}
+
+void BudgetEqualizer::_exit()
+{
+    const Compound* compound = getCompound();
+    if( !compound || _listeners.empty( ))
+        return;
+
+    for( LoadListener& listener : _listeners )
+        listener.channel->removeListener( &listener );
+    _listeners.clear();
+    _times.clear();
+}
+
+void BudgetEqualizer::notifyUpdatePre( Compound* compound,
+                                       const uint32_t frameNumber )
+{
+    _init();
+
+    // average the youngest complete samples
+    size_t nSamples = 0;
+    float maxTime = 0.f;
+    float sumTime = 0.f;
+    uint32_t nChannels = 0;
+    std::deque< FrameTime >::const_iterator i = _times.begin();
+    for( ; i != _times.end() && nSamples < NSAMPLES; ++i )
+    {
+        if( i->missing > 0 || i->nChannels == 0 ) // not yet finished
+            continue;
+        ++nSamples;
+        maxTime += i->max;
+        sumTime += i->sum;
+        nChannels += i->nChannels;
+    }
+    _times.erase( i, _times.end( ));
+
+    if( frameNumber > 0 )
+    {
+        // expect load data from all channels rendering this frame
+        uint32_t missing = 0;
+        for( const LoadListener& listener : _listeners )
+            if( listener.isActive( frameNumber ))
+                ++missing;
+        if( missing > 0 )
+            _times.push_front( FrameTime( frameNumber, missing ));
+    }
+    while( _times.size() > MAXFRAMES )
+        _times.pop_back();
+
+    if( isFrozen() || !compound->isActive() || !isActive( ))
+    {
+        compound->setMaxFPS( std::numeric_limits< float >::max( ));
+        _zoom = 1.f;
+        _applyZoom( compound );
+        return;
+    }
+
+    if( nSamples == 0 )
+        return;
+
+    const float budget = 1000.f / getFrameRate();
+    const float time = maxTime / float( nSamples );
+    const float average = sumTime / float( nChannels );
+    const bool balanced = time <= average * IMBALANCE;
+
+    // 1) Redistribution: let the load equalizers converge before dropping
+    //    resolution, since a balanced split may already fit the budget
+    if( balanced || time < budget )
+    {
+        // 2) Resolution: damped square-root controller on the critical path
+        const float factor = ( std::sqrt( budget / time ) - 1.f ) *
+                             getDamping() + 1.f;
+        _zoom = LB_MIN( 1.f, LB_MAX( MINZOOM, _zoom * factor ));
+    }
+    _applyZoom( compound );
+
+    // 3) Throttle: cap to the budget when we are faster to pace evenly
+    if( time * SLOWDOWN < budget && _zoom >= 1.f )
+        compound->setMaxFPS( getFrameRate( ));
+    else
+        compound->setMaxFPS( std::numeric_limits< float >::max( ));
+
+    LBLOG( LOG_LB2 ) << "Budget " << budget << "ms, time " << time
+                     << "ms, average " << average << "ms, zoom " << _zoom
+                     << std::endl;
+}
+
+void BudgetEqualizer::_applyZoom( Compound* compound )
+{
+    // Only children drawing into their own channel can render reduced, their
+    // output is upscaled during assembly on the parent channel
+    const Channel* channel = compound->getChannel();
+    const Compounds& children = compound->getChildren();
+    for( Compound* child : children )
+    {
+        const Channel* childChannel = child->getChannel();
+        if( !childChannel || childChannel == channel )
+            continue;
+        child->setZoom( _zoom == 1.f ? Zoom::NONE : Zoom( _zoom, _zoom ));
+    }
+}
+
+bool BudgetEqualizer::LoadListener::isActive( const uint32_t frameNumber ) const
+{
+    for( const Compound* compound : compounds )
+    {
+        if( compound->isActive() && ( frameNumber %
+                                      compound->getInheritPeriod() ==
+                                      compound->getInheritPhase( )))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void BudgetEqualizer::LoadListener::notifyLoadData(
+    Channel* channel, const uint32_t frameNumber,
+    const Statistics& statistics, const Viewport& /*region*/ )
+{
+    int64_t startTime = std::numeric_limits< int64_t >::max();
+    int64_t endTime   = 0;
+    for( const Statistic& data : statistics )
+    {
+        switch( data.type )
+        {
+            case Statistic::CHANNEL_CLEAR:
+            case Statistic::CHANNEL_DRAW:
+            case Statistic::CHANNEL_ASSEMBLE:
+            case Statistic::CHANNEL_READBACK:
+                startTime = LB_MIN( startTime, data.startTime );
+                endTime   = LB_MAX( endTime, data.endTime );
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    for( FrameTime& frameTime : parent->_times )
+    {
+        if( frameTime.frameNumber != frameNumber )
+            continue;
+
+        if( frameTime.missing > 0 )
+            --frameTime.missing;
+        if( startTime == std::numeric_limits< int64_t >::max( ))
+            return;
+
+        if( startTime == endTime ) // very fast draws might report 0 times
+            ++endTime;
+
+        const float time = float( endTime - startTime ) / float( period );
+        frameTime.max = LB_MAX( frameTime.max, time );
+        frameTime.sum += time;
+        ++frameTime.nChannels;
+        LBLOG( LOG_LB2 ) << "Frame " << frameNumber << " channel "
+                         << channel->getName() << " time " << time
+                         << std::endl;
+        return;
+    }
+}
+
+std::ostream& operator << ( std::ostream& os, const BudgetEqualizer* lb )
+{
+    if( !lb )
+        return os;
+
+    os << lunchbox::disableFlush
+       << "budget_equalizer" << std::endl
+       << '{' << std::endl
+       << "    framerate " << lb->getFrameRate() << std::endl;
+
+    if( lb->getDamping() != 0.5f )
+        os << "    damping " << lb->getDamping() << std::endl;
+
+    os << '}' << std::endl << lunchbox::enableFlush;
+    return os;
+}
+
+}
+}
@@ -0,0 +1,116 @@
+/* Copyright (c) 2016, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQS_BUDGETEQUALIZER_H
+#define EQS_BUDGETEQUALIZER_H
+
+#include "../channelListener.h" // base class
+#include "equalizer.h"          // base class
+
+#include <deque>
+
+namespace eq
+{
+namespace server
+{
+    std::ostream& operator << ( std::ostream& os, const BudgetEqualizer* );
+
+    /**
+     * Keeps a compound within a frame time budget using one controller.
+     *
+     * Replaces separate DFR and framerate equalizers on a compound tree. The
+     * frame time of all channels below the compound is sampled once, and
+     * used to decide in order:
+     * - while the channel times are imbalanced, load equalizers in the tree
+     *   are left to redistribute the work and the resolution is held,
+     * - once balanced, the zoom of the children rendering to their own
+     *   channel is adapted to fit the budget,
+     * - when the frame time is below the budget, the frame rate is throttled
+     *   to the target frame rate for even frame pacing.
+     */
+    class BudgetEqualizer : public Equalizer
+    {
+    public:
+        EQSERVER_API BudgetEqualizer();
+        virtual ~BudgetEqualizer();
+        void toStream( std::ostream& os ) const final { os << this; }
+
+        /** @sa Equalizer::attach */
+        void attach( Compound* compound ) final;
+
+        /** @sa CompoundListener::notifyUpdatePre */
+        void notifyUpdatePre( Compound* compound,
+                              const uint32_t frameNumber ) final;
+
+        uint32_t getType() const final { return fabric::BUDGET_EQUALIZER; }
+
+    protected:
+        void notifyChildAdded( Compound*, Compound* ) override
+            { LBASSERT( _listeners.empty( )); }
+        void notifyChildRemove( Compound*, Compound* ) override
+            { LBASSERT( _listeners.empty( )); }
+
+    private:
+        /** Gathered load of one frame. */
+        struct FrameTime
+        {
+            FrameTime( const uint32_t frame, const uint32_t missing_ )
+                : frameNumber( frame ), max( 0.f ), sum( 0.f ), nChannels( 0 )
+                , missing( missing_ )
+            {}
+
+            uint32_t frameNumber;
+            float max; //!< Critical path, slowest channel time in ms
+            float sum; //!< Sum of all channel times in ms
+            uint32_t nChannels; //!< Channels with a time
+            uint32_t missing; //!< Channels which did not report yet
+        };
+
+        /** Historical data, youngest first. */
+        std::deque< FrameTime > _times;
+
+        /** Helper class connected to each channel of the compound tree. */
+        class LoadListener : public ChannelListener
+        {
+        public:
+            /** @sa ChannelListener::notifyLoadData */
+            void notifyLoadData( Channel* channel, uint32_t frameNumber,
+                                 const Statistics& statistics,
+                                 const Viewport& region ) final;
+
+            /** @return true if the channel renders the given frame. */
+            bool isActive( uint32_t frameNumber ) const;
+
+            BudgetEqualizer* parent;
+            Compounds compounds; //!< All compounds rendering on the channel
+            Channel* channel;
+            uint32_t period; //!< Shortest period of the compounds
+        };
+
+        /** One listener for each channel in the tree. */
+        std::deque< LoadListener > _listeners;
+        friend class LoadListener;
+
+        float _zoom; //!< Current zoom applied to the rendering children
+
+        void _init();
+        void _exit();
+        void _applyZoom( Compound* compound );
+    };
+}
+}
+
+#endif // EQS_BUDGETEQUALIZER_H
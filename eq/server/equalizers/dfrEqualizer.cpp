@@ -26,15 +26,22 @@
 #include <eq/fabric/zoom.h>
 #include <lunchbox/debug.h>
 
+#include <cmath>
+#include <limits>
+
 namespace eq
 {
 namespace server
 {
 static const float MINSIZE = 128.f; // pixels
+static const size_t MAX_SAMPLES = 10; // frames used by the cost model
+static const size_t MAX_INFLIGHT = 32; // frames awaiting statistics
+static const float HEADROOM = .9f; // part of the frame time budget to use
 
 DFREqualizer::DFREqualizer()
         : _current ( getFrameRate( ))
         , _lastTime( 0 )
+        , _predictive( false )
 {
     LBINFO << "New DFREqualizer @" << (void*)this << std::endl;
 }
@@ -70,7 +77,8 @@ void DFREqualizer::attach( Compound* compound )
     }
 }
 
-void DFREqualizer::notifyUpdatePre( Compound* compound, const uint32_t/*frame*/)
+void DFREqualizer::notifyUpdatePre( Compound* compound,
+                                    const uint32_t frameNumber )
 {
     LBASSERT( compound == getCompound( ));
 
@@ -83,21 +91,98 @@ void DFREqualizer::notifyUpdatePre( Compound* compound, const uint32_t/*frame*/)
     LBASSERT( getDamping() >= 0.f );
     LBASSERT( getDamping() <= 1.f );
 
-    const float factor = ( sqrtf( _current / getFrameRate( )) - 1.f ) *
-                         getDamping() + 1.f;
-
     Zoom newZoom( compound->getZoom( ));
-    newZoom *= factor;
+    if( _predictive && !_samples.empty( ))
+    {
+        // Shrink right away to meet the deadline of this frame, but grow
+        // damped to not oscillate around the target
+        const float predicted = _predictZoom( compound );
+        if( predicted < newZoom.x( ))
+            newZoom.x() = predicted;
+        else
+            newZoom.x() += ( predicted - newZoom.x( )) * getDamping();
+        newZoom.y() = newZoom.x();
+    }
+    else
+    {
+        const float factor = ( sqrtf( _current / getFrameRate( )) - 1.f ) *
+                             getDamping() + 1.f;
+        newZoom *= factor;
+    }
 
-    //LBINFO << _current << ": " << factor << " = " << newZoom << std::endl;
+    _clipZoom( compound, newZoom );
+    compound->setZoom( newZoom );
 
-    // clip zoom factor to min, max( channel pvp )
-    const Compound*      parent = compound->getParent();
-    const PixelViewport& pvp    = parent->getInheritPixelViewport();
+    if( !_predictive )
+        return;
+
+    // remember rendered pixels until the statistics of this frame arrive
+    const PixelViewport& pvp = compound->getParent()->getInheritPixelViewport();
+    _pixels[ frameNumber ] = float( pvp.w ) * float( pvp.h ) *
+                             newZoom.x() * newZoom.y();
+    while( _pixels.size() > MAX_INFLIGHT )
+        _pixels.erase( _pixels.begin( ));
+}
+
+float DFREqualizer::_predictZoom( const Compound* compound ) const
+{
+    const PixelViewport& pvp = compound->getParent()->getInheritPixelViewport();
+    const float fullPixels = float( pvp.w ) * float( pvp.h );
+    const float budget = HEADROOM * 1000.f / getFrameRate();
+    return predictZoom( _samples, fullPixels, budget,
+                        compound->getZoom().x( ));
+}
+
+void DFREqualizer::_clipZoom( Compound* compound, Zoom& zoom ) const
+{
+    const PixelViewport& pvp = compound->getParent()->getInheritPixelViewport();
+    const Channel* channel = compound->getChannel();
+    zoom = clipZoom( zoom, pvp, channel->getPixelViewport( ));
+}
+
+float DFREqualizer::predictZoom( const Samples& samples,
+                                 const float fullPixels, const float budget,
+                                 const float zoom )
+{
+    // least-squares fit of time = base + perPixel * pixels
+    double sumP = 0., sumT = 0., sumPP = 0., sumPT = 0.;
+    for( const Sample& sample : samples )
+    {
+        sumP += sample.pixels;
+        sumT += sample.time;
+        sumPP += double( sample.pixels ) * double( sample.pixels );
+        sumPT += double( sample.pixels ) * double( sample.time );
+    }
+
+    const double n = double( samples.size( ));
+    const double denom = n * sumPP - sumP * sumP;
+    double base = 0.;
+    double perPixel = 0.;
+    if( denom > std::numeric_limits< float >::epsilon() * sumPP * n )
+    {
+        perPixel = ( n * sumPT - sumP * sumT ) / denom;
+        base = ( sumT - perPixel * sumP ) / n;
+    }
+    if( perPixel <= 0. || base < 0. ) // not enough variance, assume linear
+    {
+        base = 0.;
+        perPixel = sumP > 0. ? sumT / sumP : 0.;
+    }
+
+    if( perPixel <= 0. )
+        return zoom;
 
-    const Channel*       channel    = compound->getChannel();
-    const PixelViewport& channelPVP = channel->getPixelViewport();
+    const double pixels = ( double( budget ) - base ) / perPixel;
+    if( pixels <= 0. || fullPixels <= 0.f )
+        return 0.f; // clipped to the minimum size by caller
+
+    return float( std::sqrt( pixels / double( fullPixels )));
+}
 
+Zoom DFREqualizer::clipZoom( const Zoom& zoom, const PixelViewport& pvp,
+                             const PixelViewport& channelPVP )
+{
+    // clip zoom factor to min, max( channel pvp )
     const float minZoom = MINSIZE / LB_MIN( static_cast< float >( pvp.h ),
                                             static_cast< float >( pvp.w ));
     const float maxZoom = LB_MIN( static_cast< float >( channelPVP.w ) /
@@ -105,11 +190,11 @@ void DFREqualizer::notifyUpdatePre( Compound* compound, const uint32_t/*frame*/)
                                   static_cast< float >( channelPVP.h ) /
                                   static_cast< float >( pvp.h ));
 
-    newZoom.x() = LB_MAX( newZoom.x(), minZoom );
-    newZoom.x() = LB_MIN( newZoom.x(), maxZoom );
-    newZoom.y() = newZoom.x();
-
-    compound->setZoom( newZoom );
+    Zoom clipped( zoom );
+    clipped.x() = LB_MAX( clipped.x(), minZoom );
+    clipped.x() = LB_MIN( clipped.x(), maxZoom );
+    clipped.y() = clipped.x();
+    return clipped;
 }
 
 void DFREqualizer::notifyLoadData( Channel* channel, const uint32_t frameNumber,
@@ -118,6 +203,7 @@ void DFREqualizer::notifyLoadData( Channel* channel, const uint32_t frameNumber,
 {
     // gather and notify load data
     int64_t endTime = 0;
+    int64_t channelTime = 0;
     for( size_t i = 0; i < statistics.size(); ++i )
     {
         const Statistic& data = statistics[i];
@@ -128,6 +214,7 @@ void DFREqualizer::notifyLoadData( Channel* channel, const uint32_t frameNumber,
             case Statistic::CHANNEL_ASSEMBLE:
             case Statistic::CHANNEL_READBACK:
                 endTime = LB_MAX( endTime, data.endTime );
+                channelTime += data.endTime - data.startTime;
                 break;
 
             default:
@@ -138,6 +225,18 @@ void DFREqualizer::notifyLoadData( Channel* channel, const uint32_t frameNumber,
     if( endTime == 0 )
         return;
 
+    std::map< uint32_t, float >::iterator i = _pixels.find( frameNumber );
+    if( i != _pixels.end( ))
+    {
+        if( channelTime > 0 )
+        {
+            _samples.push_front( Sample( i->second, float( channelTime )));
+            if( _samples.size() > MAX_SAMPLES )
+                _samples.pop_back();
+        }
+        _pixels.erase( _pixels.begin(), ++i );
+    }
+
     const int64_t time = endTime - _lastTime;
     _lastTime = endTime;
 
@@ -161,6 +260,8 @@ std::ostream& operator << ( std::ostream& os, const DFREqualizer* lb )
 
     if( lb->getDamping() != 0.5f )
         os << "    damping " << lb->getDamping() << std::endl;
+    if( lb->isPredictive( ))
+        os << "    predictive ON" << std::endl;
 
     os << '}' << std::endl << lunchbox::enableFlush;
     return os;
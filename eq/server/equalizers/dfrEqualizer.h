@@ -1,5 +1,5 @@
 
-/* Copyright (c) 2009-2013, Stefan Eilemann <eile@equalizergraphics.com>
+/* Copyright (c) 2009-2016, Stefan Eilemann <eile@equalizergraphics.com>
  *
  * This library is free software; you can redistribute it and/or modify it under
  * the terms of the GNU Lesser General Public License version 2.1 as published
@@ -30,7 +30,15 @@ namespace server
 {
     std::ostream& operator << ( std::ostream& os, const DFREqualizer* );
 
-    /** Tries to maintain a constant frame rate by adapting the compound zoom.*/
+    /**
+     * Tries to maintain a constant frame rate by adapting the compound zoom.
+     *
+     * In the default, reactive mode the zoom is corrected after a frame
+     * missed the target frame rate. In predictive mode a linear cost model of
+     * the recent draw times over the rendered pixel count is used to choose
+     * the zoom before the frame is rendered, which keeps the frame time below
+     * the target instead of correcting it afterwards.
+     */
     class DFREqualizer : public Equalizer, protected ChannelListener
     {
     public:
@@ -53,6 +61,50 @@ namespace server
 
         uint32_t getType() const final { return fabric::DFR_EQUALIZER; }
 
+        /** Enable or disable predictive zoom selection. */
+        void setPredictive( const bool onOff ) { _predictive = onOff; }
+
+        /** @return true if the zoom is chosen using the cost model. */
+        bool isPredictive() const { return _predictive; }
+
+        /** One sample of the cost model. */
+        struct Sample
+        {
+            Sample() : pixels( 0.f ), time( 0.f ) {}
+            Sample( const float p, const float t ) : pixels( p ), time( t ) {}
+
+            float pixels; //!< Number of pixels rendered
+            float time;   //!< Channel time used to render them, in ms
+        };
+        typedef std::deque< Sample > Samples;
+
+        /**
+         * @internal
+         * Predict the zoom meeting a time budget.
+         *
+         * The samples are fitted with time = base + perPixel * pixels.
+         *
+         * @param samples the recent samples, youngest first.
+         * @param fullPixels the number of pixels rendered with a zoom of 1.
+         * @param budget the time budget of one frame, in ms.
+         * @param zoom the current zoom, returned if no prediction is
+         *             possible.
+         * @return the zoom rendering within the budget, 0 if the base cost
+         *         alone exceeds it.
+         */
+        EQSERVER_API static float predictZoom( const Samples& samples,
+                                               float fullPixels, float budget,
+                                               float zoom );
+
+        /**
+         * @internal
+         * @return the zoom clipped to a minimum size of the inherited pixel
+         *         viewport and to the size of the rendering channel.
+         */
+        EQSERVER_API static Zoom clipZoom( const Zoom& zoom,
+                                           const PixelViewport& pvp,
+                                           const PixelViewport& channelPVP );
+
     protected:
         void notifyChildAdded( Compound*, Compound* ) override {}
         void notifyChildRemove( Compound*, Compound* ) override {}
@@ -60,6 +112,14 @@ namespace server
     private:
         float _current; //!< Framerate of the last finished frame
         int64_t _lastTime; //!< Last frames' timestamp
+        bool _predictive; //!< Use the cost model to select the zoom
+
+        /** Rendered pixels of the in-flight frames, by frame number. */
+        std::map< uint32_t, float > _pixels;
+        Samples _samples; //!< Youngest samples of the cost model
+
+        float _predictZoom( const Compound* compound ) const;
+        void _clipZoom( Compound* compound, Zoom& zoom ) const;
     };
 
 }
@@ -23,6 +23,7 @@
 #include "canvas.h"
 #include "channel.h"
 #include "compound.h"
+#include "equalizers/budgetEqualizer.h"
 #include "equalizers/dfrEqualizer.h"
 #include "equalizers/framerateEqualizer.h"
 #include "equalizers/loadEqualizer.h"
@@ -70,6 +71,7 @@
         static eq::server::Segment*     segment = 0;
         static eq::server::Observer*    observer = 0;
         static eq::server::Compound*    eqCompound = 0; // avoid name clash
+        static eq::server::BudgetEqualizer* budgetEqualizer = 0;
         static eq::server::DFREqualizer* dfrEqualizer = 0;
         static eq::server::LoadEqualizer* loadEqualizer = 0;
         static eq::server::TreeEqualizer* treeEqualizer = 0;
@@ -195,6 +197,7 @@
 %token EQTOKEN_SEGMENT
 %token EQTOKEN_COMPOUND
 %token EQTOKEN_DFREQUALIZER
+%token EQTOKEN_BUDGETEQUALIZER
 %token EQTOKEN_FRAMERATEEQUALIZER
 %token EQTOKEN_LOADEQUALIZER
 %token EQTOKEN_TREEEQUALIZER
@@ -202,6 +205,7 @@
 %token EQTOKEN_VIEWEQUALIZER
 %token EQTOKEN_TILEEQUALIZER
 %token EQTOKEN_DAMPING
+%token EQTOKEN_PREDICTIVE
 %token EQTOKEN_CONNECTION
 %token EQTOKEN_NAME
 %token EQTOKEN_TYPE
@@ -1154,7 +1158,7 @@ projectionField:
         { projection.hpr = eq::fabric::Vector3f( $3, $4, $5 ); }
 
 equalizer: dfrEqualizer | framerateEqualizer | loadEqualizer | treeEqualizer |
-           monitorEqualizer | viewEqualizer | tileEqualizer
+           monitorEqualizer | viewEqualizer | tileEqualizer | budgetEqualizer
 
 dfrEqualizer: EQTOKEN_DFREQUALIZER '{'
     { dfrEqualizer = new eq::server::DFREqualizer; }
@@ -1163,6 +1167,13 @@ dfrEqualizer: EQTOKEN_DFREQUALIZER '{'
         eqCompound->addEqualizer( dfrEqualizer );
         dfrEqualizer = 0;
     }
+budgetEqualizer: EQTOKEN_BUDGETEQUALIZER '{'
+    { budgetEqualizer = new eq::server::BudgetEqualizer; }
+    budgetEqualizerFields '}'
+    {
+        eqCompound->addEqualizer( budgetEqualizer );
+        budgetEqualizer = 0;
+    }
 framerateEqualizer: EQTOKEN_FRAMERATEEQUALIZER '{' '}'
     {
         eqCompound->addEqualizer( new eq::server::FramerateEqualizer );
@@ -1201,6 +1212,13 @@ dfrEqualizerFields: /* null */ | dfrEqualizerFields dfrEqualizerField
 dfrEqualizerField:
     EQTOKEN_DAMPING FLOAT      { dfrEqualizer->setDamping( $2 ); }
     | EQTOKEN_FRAMERATE FLOAT  { dfrEqualizer->setFrameRate( $2 ); }
+    | EQTOKEN_PREDICTIVE IATTR
+        { dfrEqualizer->setPredictive( $2 == eq::fabric::ON ); }
+
+budgetEqualizerFields: /* null */ | budgetEqualizerFields budgetEqualizerField
+budgetEqualizerField:
+    EQTOKEN_DAMPING FLOAT      { budgetEqualizer->setDamping( $2 ); }
+    | EQTOKEN_FRAMERATE FLOAT  { budgetEqualizer->setFrameRate( $2 ); }
 
 loadEqualizerFields: /* null */ | loadEqualizerFields loadEqualizerField
 loadEqualizerField:
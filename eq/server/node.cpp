@@ -88,6 +88,7 @@ Node::Node( Config* parent )
     , _flushedFrame( 0 )
     , _state( STATE_STOPPED )
     , _bufferedTasks( new co::BufferConnection )
+    , _nTasks( 0 )
     , _lastDrawPipe( 0 )
 {
     const Global* global = Global::instance();
@@ -629,6 +630,7 @@ co::ObjectOCommand Node::send( const uint32_t cmd )
 
 co::ObjectOCommand Node::send( const uint32_t cmd, const uint128_t& id )
 {
+    ++_nTasks;
     return co::ObjectOCommand( co::Connections( 1, _bufferedTasks ), cmd,
                                co::COMMANDTYPE_OBJECT, id, CO_INSTANCE_ALL );
 }
@@ -640,7 +642,8 @@ EventOCommand Node::sendError( const uint32_t error )
 
 void Node::flushSendBuffer()
 {
-    _bufferedTasks->sendBuffer( _node->getConnection( ));
+    _bufferedTasks->sendBuffer( _taskConnection ? _taskConnection :
+                                                  _node->getConnection( ));
 }
 
 //===========================================================================
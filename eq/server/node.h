@@ -173,6 +173,17 @@ public:
 
     void flushSendBuffer();
 
+    /**
+     * @internal
+     * Send all task commands to the given connection instead of the render
+     * client, e.g., to simulate a config without render clients.
+     */
+    void setTaskConnection( co::ConnectionPtr connection )
+        { _taskConnection = connection; }
+
+    /** @internal @return the number of task commands sent. */
+    uint64_t getNumTasks() const { return _nTasks; }
+
     /**
      * Add a new description how this node can be reached.
      *
@@ -275,6 +286,12 @@ private:
     /** Task commands for the current operation. */
     co::BufferConnectionPtr _bufferedTasks;
 
+    /** The number of task commands sent to the render client. */
+    uint64_t _nTasks;
+
+    /** The connection replacing the render client connection, if set. */
+    co::ConnectionPtr _taskConnection;
+
     /** The last draw pipe for this entity */
     const Pipe* _lastDrawPipe;
 
@@ -30,6 +30,7 @@ namespace eq
 namespace server
 {
 
+class BudgetEqualizer;
 class Canvas;
 class Channel;
 class ChannelListener;
@@ -36,6 +36,9 @@
 
 #include <boost/foreach.hpp>
 
+#include <algorithm>
+#include <map>
+
 namespace eq
 {
 namespace server
@@ -43,6 +46,27 @@ namespace server
 typedef fabric::Window< Pipe, Window, Channel > Super;
 typedef co::CommandFunc<Window> WindowFunc;
 
+namespace
+{
+/** The peers of one participant in a dissemination barrier. */
+struct DisseminationBarrier
+{
+    uint128_t id;
+    uint32_t rank;
+    std::vector< uint128_t > nodes; //!< the node to signal in each round
+    co::NodeIDs netNodes;
+    std::vector< uint32_t > ranks; //!< the rank to signal in each round
+};
+typedef std::map< const co::Barrier*, DisseminationBarrier >
+    DisseminationBarriers;
+}
+
+struct Window::Private
+{
+    /** The swap barriers entered using a dissemination barrier. */
+    DisseminationBarriers disseminationBarriers;
+};
+
 Window::Window( Pipe* parent )
         : Super( parent )
         , _active( 0 )
@@ -53,6 +77,7 @@ Window::Window( Pipe* parent )
         , _lastDrawChannel( 0 )
         , _swapFinish( false )
         , _swap( false )
+        , _private( new Private )
 {
     const Global* global = Global::instance();
     for( unsigned i = 0; i < WindowSettings::IATTR_ALL; ++i )
@@ -64,6 +89,7 @@ Window::Window( Pipe* parent )
 
 Window::~Window()
 {
+    delete _private;
 }
 
 void Window::attach( const uint128_t& id, const uint32_t instanceID )
@@ -208,6 +234,39 @@ void Window::_resetSwapBarriers()
     _nvNetBarrier = 0;
     _masterBarriers.clear();
     _barriers.clear();
+    _private->disseminationBarriers.clear();
+}
+
+bool Window::hasSwapBarrier( const co::Barrier* barrier ) const
+{
+    return std::find( _barriers.begin(), _barriers.end(), barrier ) !=
+           _barriers.end();
+}
+
+void Window::joinDisseminationBarrier( const co::Barrier* barrier,
+                                       const uint128_t& id,
+                                       const Windows& participants,
+                                       const uint32_t rank )
+{
+    const size_t size = participants.size();
+    LBASSERT( rank < size );
+    LBASSERT( participants[ rank ] == this );
+    LBASSERT( hasSwapBarrier( barrier ));
+
+    DisseminationBarrier& dissemination =
+        _private->disseminationBarriers[ barrier ];
+    dissemination.id = id;
+    dissemination.rank = rank;
+
+    for( size_t distance = 1; distance < size; distance <<= 1 )
+    {
+        const size_t peerRank = ( rank + distance ) % size;
+        const Node* peer = participants[ peerRank ]->getNode();
+
+        dissemination.nodes.push_back( peer->getID( ));
+        dissemination.netNodes.push_back( peer->getNode()->getNodeID( ));
+        dissemination.ranks.push_back( uint32_t( peerRank ));
+    }
 }
 
 co::Barrier* Window::joinSwapBarrier( co::Barrier* barrier )
@@ -445,6 +504,23 @@ void Window::_updateSwap( const uint32_t frameNumber )
             continue;
         }
 
+        const DisseminationBarriers& disseminationBarriers =
+            _private->disseminationBarriers;
+        DisseminationBarriers::const_iterator j =
+            disseminationBarriers.find( barrier );
+        if( j != disseminationBarriers.end( ))
+        {
+            const DisseminationBarrier& dissemination = j->second;
+            send( fabric::CMD_WINDOW_DISSEMINATION_BARRIER )
+                << dissemination.id << dissemination.rank
+                << dissemination.nodes << dissemination.netNodes
+                << dissemination.ranks;
+            LBLOG( LOG_TASKS ) << "TASK barrier  dissemination "
+                               << dissemination.id << " rank "
+                               << dissemination.rank << std::endl;
+            continue;
+        }
+
         send( fabric::CMD_WINDOW_BARRIER ) << co::ObjectVersion( barrier );
         LBLOG( LOG_TASKS ) << "TASK barrier  barrier "
                            << co::ObjectVersion( barrier ) << std::endl;
@@ -118,6 +118,27 @@ public:
     /** @return true if this window has entered a NV_swap_group. */
     bool hasNVSwapBarrier() const { return (_nvSwapBarrier != 0); }
 
+    /** @return true if this window enters the given swap barrier. */
+    bool hasSwapBarrier( const co::Barrier* barrier ) const;
+
+    /**
+     * Enter the given swap barrier using a dissemination barrier.
+     *
+     * Instead of entering the centralized net::Barrier, each participant
+     * signals the participant at distance 2^k and waits for the signal of the
+     * participant at distance -2^k in round k, that is, all participants are
+     * released after log2(n) rounds.
+     *
+     * @param barrier the joined net::Barrier of the swap barrier group.
+     * @param id the unique identifier of the barrier for this frame.
+     * @param participants all windows entering the barrier.
+     * @param rank the index of this window in the participants.
+     */
+    void joinDisseminationBarrier( const co::Barrier* barrier,
+                                   const uint128_t& id,
+                                   const Windows& participants,
+                                   uint32_t rank );
+
     /** The last drawing channel for this entity. @internal */
     void setLastDrawChannel( const Channel* channel )
     { _lastDrawChannel = channel; }
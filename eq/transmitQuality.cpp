@@ -0,0 +1,46 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation .
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "transmitQuality.h"
+
+#include <algorithm>
+
+namespace eq
+{
+const float TransmitQuality::STEP = .25f;
+
+TransmitQuality::TransmitQuality()
+    : _loss( 0.f )
+{}
+
+float TransmitQuality::update( const bool moving, const int64_t busyTime,
+                               const int64_t interval )
+{
+    if( !moving ) // lossless refinement
+        _loss = 0.f;
+    else if( busyTime * 10 >= interval * 9 )
+        _loss = std::min( _loss + STEP, 1.f );
+    else if( busyTime * 2 <= interval )
+        _loss = std::max( _loss - STEP, 0.f );
+    return _loss;
+}
+
+float TransmitQuality::getQuality( const float quality,
+                                   const float minQuality ) const
+{
+    return std::min( quality, 1.f - _loss * ( 1.f - minQuality ));
+}
+}
@@ -0,0 +1,67 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation .
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_TRANSMITQUALITY_H
+#define EQ_TRANSMITQUALITY_H
+
+#include <eq/api.h>
+#include <eq/types.h>
+
+namespace eq
+{
+/**
+ * @internal
+ * The adaptive loss of the image transmission of one channel.
+ *
+ * While the rendering is in motion, the loss is raised by one step if the
+ * transmission was busy during at least 90% of the last frame, and lowered by
+ * one step if it was idle during at least half of it. The first frame without
+ * motion resets the loss for a lossless refinement.
+ */
+class TransmitQuality
+{
+public:
+    /** The change of the loss per frame. */
+    static const float STEP;
+
+    /** Construct a new lossless transmission quality. */
+    EQ_API TransmitQuality();
+
+    /**
+     * Update the loss for a new frame.
+     *
+     * @param moving true if the rendering of the new frame is in motion.
+     * @param busyTime the transmission time during the last frame.
+     * @param interval the time since the start of the last frame.
+     * @return the new loss, from 0 (lossless) to 1 (lowest quality).
+     */
+    EQ_API float update( bool moving, int64_t busyTime, int64_t interval );
+
+    /** @return the current loss, from 0 (lossless) to 1 (lowest quality). */
+    float getLoss() const { return _loss; }
+
+    /**
+     * @return the given quality lowered by the current loss down to the given
+     *         minimum quality.
+     */
+    EQ_API float getQuality( float quality, float minQuality ) const;
+
+private:
+    float _loss;
+};
+}
+
+#endif // EQ_TRANSMITQUALITY_H
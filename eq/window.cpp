@@ -22,6 +22,7 @@
 #include "channel.h"
 #include "client.h"
 #include "config.h"
+#include "cpu/window.h"
 #include "error.h"
 #include "gl.h"
 #include "global.h"
@@ -48,7 +49,11 @@
 #include <co/barrier.h>
 #include <co/exception.h>
 #include <co/objectICommand.h>
+#include <lunchbox/clock.h>
 #include <lunchbox/sleep.h>
+#include <lunchbox/thread.h>
+
+#include <algorithm>
 
 namespace eq
 {
@@ -63,8 +68,21 @@ namespace
 {
 const char* _smallFontKey  = "eq_small_font";
 const char* _mediumFontKey = "eq_medium_font";
+
+// time busy-waited before a throttled swap to absorb sleep inaccuracy, in ms
+static const double PACING_SPIN_TIME = 1.0;
 }
 
+/** Frame pacing state of _cmdThrottleFramerate */
+struct Window::Private
+{
+    Private() : swapTarget( 0. ), sleepOvershoot( 0. ) {}
+
+    lunchbox::Clock clock; //!< high-resolution pacing clock
+    double swapTarget; //!< absolute target time of the last swap, in ms
+    double sleepOvershoot; //!< averaged oversleep of lunchbox::sleep, in ms
+};
+
 Window::Window( Pipe* parent )
         : Super( parent )
         , _sharedContextWindow( 0 ) // default set below
@@ -74,7 +92,7 @@ Window::Window( Pipe* parent )
         , _objectManager( 0 )
         , _lastTime ( 0.0f )
         , _avgFPS ( 0.0f )
-        , _lastSwapTime( 0 )
+        , _private( new Private )
 {
     const Windows& windows = parent->getWindows();
     if( windows.empty( ))
@@ -86,6 +104,7 @@ Window::Window( Pipe* parent )
 Window::~Window()
 {
     LBASSERT( getChannels().empty( ));
+    delete _private;
 }
 
 void Window::attach( const uint128_t& id, const uint32_t instanceID )
@@ -117,6 +136,9 @@ void Window::attach( const uint128_t& id, const uint32_t instanceID )
                      WindowFunc( this, &Window::_cmdBarrier ), queue );
     registerCommand( fabric::CMD_WINDOW_NV_BARRIER,
                      WindowFunc( this, &Window::_cmdNVBarrier ), queue );
+    registerCommand( fabric::CMD_WINDOW_DISSEMINATION_BARRIER,
+                     WindowFunc( this, &Window::_cmdDisseminationBarrier ),
+                     queue );
     registerCommand( fabric::CMD_WINDOW_SWAP,
                      WindowFunc( this, &Window::_cmdSwap), queue );
     registerCommand( fabric::CMD_WINDOW_FRAME_DRAW_FINISH,
@@ -477,6 +499,9 @@ const util::BitmapFont* Window::getMediumFont()
 
 bool Window::configInitGL( const uint128_t& )
 {
+    if( dynamic_cast< const cpu::Window* >( getSystemWindow( )))
+        return true; // no OpenGL state in main memory
+
     const bool coreProfile = getIAttribute(
                 WindowSettings::IATTR_HINT_CORE_PROFILE ) == ON;
     if( !coreProfile )
@@ -817,7 +842,7 @@ bool Window::processEvent( Statistic& event )
 {
     Config* config = getConfig();
     updateEvent( event, config->getTime( ));
-    config->sendEvent( EVENT_STATISTIC ) << event;
+    config->sendStatistic( event );
     return true;
 }
 
@@ -994,18 +1019,40 @@ bool  Window::_cmdThrottleFramerate( co::ICommand& cmd )
     LBLOG( LOG_TASKS ) << "TASK throttle framerate " << getName() << " "
                        << command << std::endl;
 
-    // throttle to given framerate
-    const int64_t elapsed  = getConfig()->getTime() - _lastSwapTime;
+    // throttle to given framerate: swaps are scheduled at absolute target
+    // times, one minFrameTime apart, to avoid jitter and drift
     const float minFrameTime = command.read< float >();
-    const float timeLeft = minFrameTime - static_cast<float>( elapsed );
+    const lunchbox::Clock& clock = _private->clock;
+    double& target = _private->swapTarget;
+    const double now = clock.getTimed();
+
+    target += minFrameTime;
+    if( target < now - minFrameTime ) // more than a frame late, resync
+        target = now;
 
-    if( timeLeft >= 1.f )
+    if( target > now )
     {
         WindowStatistics stat( Statistic::WINDOW_THROTTLE_FRAMERATE, this );
-        lunchbox::sleep( static_cast< uint32_t >( timeLeft ));
+
+        // sleep coarsely, compensating the measured oversleep, then spin
+        const double sleepTime = target - now - PACING_SPIN_TIME -
+                                 _private->sleepOvershoot;
+        if( sleepTime >= 1. )
+        {
+            const uint32_t ms = static_cast< uint32_t >( sleepTime );
+            const double start = clock.getTimed();
+            lunchbox::sleep( ms );
+            const double overshoot = clock.getTimed() - start - double( ms );
+            _private->sleepOvershoot = .9 * _private->sleepOvershoot +
+                                       .1 * std::max( overshoot, 0. );
+        }
+        while( clock.getTimed() < target )
+            lunchbox::Thread::yield();
     }
 
-    _lastSwapTime = getConfig()->getTime();
+    WindowStatistics stat( Statistic::WINDOW_PACING_ERROR, this );
+    stat.statistic.pacingError = static_cast< float >( clock.getTimed() -
+                                                       target );
     return true;
 }
 
@@ -1039,6 +1086,27 @@ bool Window::_cmdNVBarrier( co::ICommand& cmd )
     return true;
 }
 
+bool Window::_cmdDisseminationBarrier( co::ICommand& cmd )
+{
+    co::ObjectICommand command( cmd );
+    const uint128_t& barrier = command.read< uint128_t >();
+    const uint32_t rank = command.read< uint32_t >();
+    const std::vector< uint128_t >& nodes =
+        command.read< std::vector< uint128_t > >();
+    const co::NodeIDs& netNodes = command.read< co::NodeIDs >();
+    const std::vector< uint32_t >& ranks =
+        command.read< std::vector< uint32_t > >();
+
+    LBLOG( LOG_TASKS ) << "TASK swap barrier  " << getName() << " rank "
+                       << rank << " of " << barrier << std::endl;
+
+    WindowStatistics stat( Statistic::WINDOW_SWAP_BARRIER, this );
+    const uint32_t timeout = getConfig()->getTimeout() / 2;
+    LBCHECK( getNode()->enterBarrier( barrier, rank, nodes, netNodes, ranks,
+                                      timeout ));
+    return true;
+}
+
 bool Window::_cmdSwap( co::ICommand& cmd )
 {
     co::ObjectICommand command( cmd );
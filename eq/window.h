@@ -373,7 +373,7 @@ protected:
      * Initialize the OpenGL state for this window.
      *
      * Called from configInit(), after the system window has been successfully
-     * initialized.
+     * initialized. Does nothing for a cpu::Window.
      *
      * @param initID the init identifier.
      * @return true if the initialization was successful, false if not.
@@ -471,9 +471,6 @@ private:
         BACK  = 1
     };
 
-    /** The time of the last swap command. */
-    int64_t _lastSwapTime;
-
     /** List of channels that have grabbed the mouse. */
     Channels _grabbedChannels;
 
@@ -510,6 +507,7 @@ private:
     bool _cmdFinish( co::ICommand& command );
     bool _cmdBarrier( co::ICommand& command );
     bool _cmdNVBarrier( co::ICommand& command );
+    bool _cmdDisseminationBarrier( co::ICommand& command );
     bool _cmdSwap( co::ICommand& command );
     bool _cmdFrameDrawFinish( co::ICommand& command );
     bool _cmdResize( co::ICommand& command );
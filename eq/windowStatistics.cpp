@@ -49,7 +49,8 @@ WindowStatistics::WindowStatistics( const Statistic::Type type,
         snprintf( statistic.resourceName, 32, "%s", name.c_str());
     statistic.resourceName[31] = 0;
 
-    if( type != Statistic::WINDOW_FPS && hint == NICEST )
+    if( type != Statistic::WINDOW_FPS &&
+        type != Statistic::WINDOW_PACING_ERROR && hint == NICEST )
         window->finish();
 
     statistic.startTime  = window->getConfig()->getTime();
@@ -66,7 +67,8 @@ WindowStatistics::~WindowStatistics()
     if( statistic.frameNumber == 0 ) // does not belong to a frame
         return;
 
-    if( statistic.type != Statistic::WINDOW_FPS && hint == NICEST )
+    if( statistic.type != Statistic::WINDOW_FPS &&
+        statistic.type != Statistic::WINDOW_PACING_ERROR && hint == NICEST )
         _owner->finish();
 
     statistic.endTime = _owner->getConfig()->getTime();
@@ -33,7 +33,6 @@ namespace x11
 /**
  * A system window for CPU rendering on X11.
  *
- * Example usage: @include examples/eqCPU/window.cpp
  * @version 1.9
  */
 class Window : public SystemWindow
@@ -27,12 +27,15 @@
  */
 
 #include "channel.h"
-#include <eq/x11/window.h>
-#include <eq/system.h>
+
 #include <eq/window.h>
 
 namespace eqCpu
 {
+namespace
+{
+static const size_t NBOXES = 16;
+}
 
 Channel::Channel( eq::Window* parent )
     : eq::Channel( parent )
@@ -41,43 +44,41 @@ Channel::Channel( eq::Window* parent )
 
 void Channel::frameDraw( const eq::uint128_t& )
 {
-    eq::x11::Window* x11Window = static_cast< eq::x11::Window* >(
-                               getWindow()->getSystemWindow( ));
-    Display* display = x11Window->getXDisplay();
-    XID drawable = x11Window->getXDrawable();
-    const int screen = DefaultScreen( display );
-
-    XFillRectangle( display, drawable, DefaultGC( display, screen ),
-                    20, 20, 50, 50 );
-}
-
-void Channel::frameClear( const eq::uint128_t& )
-{
+    // A diagonal row of overlapping boxes, distributed over the database range
     const eq::PixelViewport& pvp = getPixelViewport();
-    eq::x11::Window* x11Window = static_cast< eq::x11::Window* >(
-                               getWindow()->getSystemWindow( ));
-    Display* display = x11Window->getXDisplay();
-    XID drawable = x11Window->getXDrawable();
+    const eq::Viewport& vp = getViewport();
+    const eq::Range& range = getRange();
+    const size_t begin = size_t( range.start * NBOXES + .5f );
+    const size_t end = size_t( range.end * NBOXES + .5f );
 
-    XClearArea( display, drawable, pvp.x, pvp.y, pvp.w, pvp.h, false );
-}
+    for( size_t i = begin; i < end; ++i )
+    {
+        const float pos = float( i ) / float( NBOXES );
+        const float x = ( .1f + .6f * pos - vp.x ) / vp.w;
+        const float y = ( .1f + .6f * pos - vp.y ) / vp.h;
+        eq::PixelViewport box( pvp.x + int32_t( x * pvp.w ),
+                               pvp.y + int32_t( y * pvp.h ),
+                               int32_t( .2f / vp.w * pvp.w ),
+                               int32_t( .2f / vp.h * pvp.h ));
+        box.intersect( pvp );
 
-void Channel::frameReadback( const eq::uint128_t&, const eq::Frames& )
-{
-    LBUNIMPLEMENTED;
+        // later boxes are in front
+        const uint32_t depth = eq::cpu::Window::FAR_DEPTH / ( NBOXES + 1 ) *
+                               uint32_t( NBOXES - i );
+        const eq::Vector4ub color( uint8_t( 255.f * pos ), 128,
+                                   uint8_t( 255.f * ( 1.f - pos )), 255 );
+        _getCPUWindow()->fill( box, color, depth );
+    }
 }
 
-void Channel::frameAssemble( const eq::uint128_t&, const eq::Frames& )
-{
-    LBUNIMPLEMENTED;
-}
-
-void Channel::setupAssemblyState()
+void Channel::frameClear( const eq::uint128_t& )
 {
+    _getCPUWindow()->clear( getPixelViewport(), eq::Vector4ub( 0, 0, 0, 255 ));
 }
 
-void Channel::resetAssemblyState()
+eq::cpu::Window* Channel::_getCPUWindow()
 {
+    return static_cast< eq::cpu::Window* >( getWindow()->getSystemWindow( ));
 }
 
 }
@@ -26,10 +26,11 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 
-#ifndef EQ_CPU_CHANNEL_H
-#define EQ_CPU_CHANNEL_H
+#ifndef EQCPU_CHANNEL_H
+#define EQCPU_CHANNEL_H
 
 #include <eq/channel.h> // base class
+#include <eq/cpu/window.h> // used inline
 
 namespace eqCpu
 {
@@ -47,12 +48,10 @@ protected:
 
     void frameDraw( const eq::uint128_t& frameID ) final;
     void frameClear( const eq::uint128_t& frameID ) final;
-    void frameReadback( const eq::uint128_t&, const eq::Frames& ) final;
-    void frameAssemble( const eq::uint128_t&, const eq::Frames& ) final;
 
-    void setupAssemblyState() final;
-    void resetAssemblyState() final;
+private:
+    eq::cpu::Window* _getCPUWindow();
 };
 }
 
-#endif // EQ_CPU_CHANNEL_H
+#endif // EQCPU_CHANNEL_H
@@ -28,7 +28,6 @@
 
 #include "channel.h"
 #include "pipe.h"
-#include "window.h"
 
 #include <eq/client.h>
 #include <eq/config.h>
@@ -43,8 +42,6 @@ class NodeFactory : public eq::NodeFactory
 public:
     eq::Pipe* createPipe( eq::Node* parent ) final
         { return new eqCpu::Pipe( parent ); }
-    eq::Window* createWindow( eq::Pipe* parent ) final
-        { return new eqCpu::Window( parent ); }
     eq::Channel* createChannel( eq::Window* parent ) final
         { return new eqCpu::Channel( parent ); }
 };
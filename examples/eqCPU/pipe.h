@@ -26,8 +26,8 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 
-#ifndef EQ_CPU_PIPE_H
-#define EQ_CPU_PIPE_H
+#ifndef EQCPU_PIPE_H
+#define EQCPU_PIPE_H
 
 #include <eq/pipe.h> // base class
 #include <eq/windowSystem.h> // used inline
@@ -43,9 +43,9 @@ public:
 protected:
     eq::MessagePump* createMessagePump() final { return 0; }
     eq::WindowSystem selectWindowSystem() const final
-        { return eq::WindowSystem( "GLX" ); }
+        { return eq::WindowSystem( "CPU" ); }
 };
 
 }
 
-#endif // EQ_CPU_PIPE_H
+#endif // EQCPU_PIPE_H
@@ -0,0 +1,158 @@
+
+/* Copyright (c) 2016, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Eyescale Software GmbH nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "benchmark.h"
+
+#include <algorithm>
+#include <fstream>
+
+namespace eqPly
+{
+namespace
+{
+static const int PERCENTILES[] = { 50, 95, 99 };
+
+/** @return the nearest-rank percentile of the given sorted values. */
+int64_t _percentile( const std::vector< int64_t >& values, const int p )
+{
+    if( values.empty( ))
+        return 0;
+    const size_t rank = ( values.size() * p + 99 ) / 100;
+    return values[ std::max( rank, size_t( 1 )) - 1 ];
+}
+}
+
+void Benchmark::add( const eq::Statistic& statistic )
+{
+    if( statistic.frameNumber == 0 )
+        return;
+
+    Stage stage = STAGE_ALL;
+    switch( statistic.type )
+    {
+    case eq::Statistic::CHANNEL_DRAW:
+        stage = STAGE_DRAW;
+        break;
+    case eq::Statistic::CHANNEL_READBACK:
+    case eq::Statistic::CHANNEL_ASYNC_READBACK:
+        stage = STAGE_READBACK;
+        break;
+    case eq::Statistic::CHANNEL_FRAME_COMPRESS:
+        stage = STAGE_COMPRESS;
+        break;
+    case eq::Statistic::CHANNEL_FRAME_TRANSMIT:
+        stage = STAGE_TRANSMIT;
+        break;
+    case eq::Statistic::CHANNEL_ASSEMBLE:
+        stage = STAGE_ASSEMBLE;
+        break;
+    case eq::Statistic::WINDOW_SWAP_BARRIER:
+        stage = STAGE_SWAP_BARRIER;
+        break;
+    case eq::Statistic::CONFIG_START_FRAME:
+    case eq::Statistic::CONFIG_FINISH_FRAME:
+        break;
+    default:
+        return;
+    }
+
+    std::lock_guard< std::mutex > mutex( _lock );
+    Frame& frame = _frames[ statistic.frameNumber ];
+
+    if( statistic.type == eq::Statistic::CONFIG_START_FRAME )
+        frame.start = statistic.startTime;
+    else if( statistic.type == eq::Statistic::CONFIG_FINISH_FRAME )
+        frame.finish = statistic.endTime;
+    else
+    {
+        std::map< uint32_t, Times >::iterator i =
+            frame.resources.find( statistic.serial );
+        if( i == frame.resources.end( ))
+        {
+            Times times;
+            times.fill( 0 );
+            i = frame.resources.insert( std::make_pair( statistic.serial,
+                                                        times )).first;
+        }
+        i->second[ stage ] += statistic.endTime - statistic.startTime;
+    }
+}
+
+bool Benchmark::write( const std::string& filename ) const
+{
+    std::ofstream file( filename.c_str( ));
+    if( !file.is_open( ))
+    {
+        LBERROR << "Can't open " << filename << " for writing" << std::endl;
+        return false;
+    }
+
+    // stage times of all complete frames, with the total frame time last
+    std::vector< std::vector< int64_t > > stages( STAGE_ALL + 1 );
+    file << "frame, draw, readback, compress, transmit, assemble, "
+         << "swapBarrier, total" << std::endl;
+
+    std::lock_guard< std::mutex > mutex( _lock );
+    for( const auto& i : _frames )
+    {
+        const Frame& frame = i.second;
+        if( frame.start < 0 || frame.finish < 0 )
+            continue;
+
+        Times times;
+        times.fill( 0 );
+        for( const auto& j : frame.resources )
+            for( size_t k = 0; k < STAGE_ALL; ++k )
+                times[ k ] = std::max( times[ k ], j.second[ k ] );
+
+        file << i.first;
+        for( size_t k = 0; k < STAGE_ALL; ++k )
+        {
+            file << ", " << times[ k ];
+            stages[ k ].push_back( times[ k ] );
+        }
+        file << ", " << frame.finish - frame.start << std::endl;
+        stages[ STAGE_ALL ].push_back( frame.finish - frame.start );
+    }
+
+    for( std::vector< int64_t >& values : stages )
+        std::sort( values.begin(), values.end( ));
+
+    for( const int p : PERCENTILES )
+    {
+        file << "p" << p;
+        for( const std::vector< int64_t >& values : stages )
+            file << ", " << _percentile( values, p );
+        file << std::endl;
+    }
+
+    LBINFO << "Wrote benchmark report of " << stages.back().size()
+           << " frames to " << filename << std::endl;
+    return file.good();
+}
+}
@@ -1,5 +1,5 @@
 
-/* Copyright (c) 2009-2015, Stefan.Eilemann@epfl.ch
+/* Copyright (c) 2016, Stefan Eilemann <eile@equalizergraphics.com>
  *
  * Redistribution and use in source and binary forms, with or without
  * modification, are permitted provided that the following conditions are met:
@@ -26,25 +26,61 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 
-#ifndef EQ_CPU_WINDOW_H
-#define EQ_CPU_WINDOW_H
+#ifndef EQ_PLY_BENCHMARK_H
+#define EQ_PLY_BENCHMARK_H
 
-#include <eq/window.h> // base class
+#include <eq/eq.h>
 
-namespace eqCpu
+#include <array>
+#include <map>
+#include <mutex>
+
+namespace eqPly
 {
-class Window : public eq::Window
+/**
+ * Collects the statistics of all resources during a benchmark run and writes
+ * the per-frame and percentile times of each stage of the frame.
+ */
+class Benchmark
 {
 public:
-    Window( eq::Pipe* parent );
+    /** Add a statistic of any resource. Thread safe. */
+    void add( const eq::Statistic& statistic );
 
-protected:
-    bool configInitSystemWindow( const eq::uint128_t& initID ) final;
+    /**
+     * Write the report as comma-separated values.
+     *
+     * One row per complete frame, followed by the p50, p95 and p99 rows. All
+     * times are in milliseconds. The stage time of a frame is the time of the
+     * slowest resource in that stage.
+     */
+    bool write( const std::string& filename ) const;
 
-    bool configInitGL( const eq::uint128_t& ) final { return true; }
-    bool configExitGL() final { return true; }
-};
+private:
+    enum Stage
+    {
+        STAGE_DRAW,
+        STAGE_READBACK,
+        STAGE_COMPRESS,
+        STAGE_TRANSMIT,
+        STAGE_ASSEMBLE,
+        STAGE_SWAP_BARRIER,
+        STAGE_ALL
+    };
+    typedef std::array< int64_t, STAGE_ALL > Times;
 
+    struct Frame
+    {
+        Frame() : start( -1 ), finish( -1 ) {}
+
+        std::map< uint32_t, Times > resources; // by serial
+        int64_t start; // of Config::startFrame
+        int64_t finish; // of Config::finishFrame
+    };
+
+    mutable std::mutex _lock;
+    std::map< uint32_t, Frame > _frames;
+};
 }
 
-#endif // EQ_CPU_WINDOW_H
+#endif // EQ_PLY_BENCHMARK_H
@@ -53,6 +53,10 @@ namespace eqPly
 
         uint32_t getCurrentFrame() { return _curFrame; }
 
+        /** @return the number of frames of one pass through the path. */
+        uint32_t getNumFrames() const
+            { return _steps.size() < 2 ? 0 : _steps.back().frame; }
+
         const eq::Vector3f& getModelRotation() const { return _modelRotation;}
 
         struct Step
@@ -246,10 +246,12 @@ void Channel::frameReadback( const eq::uint128_t& frameID,
         // OPT: Drop alpha channel from all frames during network transport
         frame->setAlphaUsage( false );
 
-        if( frameData.isIdle( ))
-            frame->setQuality( eq::Frame::Buffer::color, 1.f );
-        else
-            frame->setQuality( eq::Frame::Buffer::color, frameData.getQuality());
+        // Lower the quality during interaction only if the transmission is the
+        // bottleneck, idle frames are transmitted lossless
+        frame->setQuality( eq::Frame::Buffer::color, 1.f );
+        frame->setAdaptiveQuality( eq::Frame::Buffer::color,
+                                   frameData.getQuality( ));
+        frame->setMoving( !frameData.isIdle( ));
 
         if( frameData.useCompression( ))
             frame->useCompressor( eq::Frame::Buffer::color, EQ_COMPRESSOR_AUTO );
@@ -47,6 +47,8 @@ Config::Config( eq::ServerPtr parent )
         , _spinY( 5 )
         , _advance( 0 )
         , _currentCanvas( 0 )
+        , _nextModelFile( 0 )
+        , _nLoadingModels( 0 )
         , _messageTime( 0 )
         , _redraw( true )
         , _useIdleAA( true )
@@ -56,10 +58,16 @@ Config::Config( eq::ServerPtr parent )
 
 Config::~Config()
 {
+    _joinModelLoaders();
+
     for( ModelsCIter i = _models.begin(); i != _models.end(); ++i )
         delete *i;
     _models.clear();
 
+    for( Model* model : _loadedModels )
+        delete model;
+    _loadedModels.clear();
+
     for( ModelDistsCIter i = _modelDist.begin(); i != _modelDist.end(); ++i )
         delete *i;
     _modelDist.clear();
@@ -81,6 +89,9 @@ bool Config::init()
     _initData.setFrameDataID( _frameData.getID( ));
     registerObject( &_initData );
 
+    // merge the motion events queued during slow frames
+    setEventCoalescing( true );
+
     // init config
     if( !eq::Config::init( _initData.getID( )))
     {
@@ -103,7 +114,15 @@ bool Config::init()
 
 bool Config::exit()
 {
+    const std::string& benchmark = _initData.getBenchmarkFilename();
+    if( !benchmark.empty( ))
+    {
+        handleEvents(); // statistics of the last frames
+        _benchmark.write( benchmark );
+    }
+
     const bool ret = eq::Config::exit(); // cppcheck-suppress unreachableCode
+    _joinModelLoaders();
     _deregisterData();
     _closeAdminServer();
 
@@ -130,7 +149,8 @@ static bool _isPlyfile( const std::string& filename )
 
 void Config::_loadModels()
 {
-    if( !_models.empty( )) // only load on the first config run
+    // only load on the first config run
+    if( !_models.empty() || !_loadedModels.empty( ))
         return;
 
     eq::Strings filenames = _initData.getFilenames();
@@ -140,20 +160,7 @@ void Config::_loadModels()
         filenames.pop_back();
 
         if( _isPlyfile( filename ))
-        {
-            Model* model = new Model;
-
-            if( _initData.useInvertedFaces() )
-                model->useInvertedFaces();
-
-            if( !model->readFromFile( filename.c_str( )))
-            {
-                LBWARN << "Can't load model: " << filename << std::endl;
-                delete model;
-            }
-            else
-                _models.push_back( model );
-        }
+            _modelFiles.push_back( filename );
         else
         {
             const std::string basename = lunchbox::getFilename( filename );
@@ -167,22 +174,83 @@ void Config::_loadModels()
                 filenames.push_back( filename + '/' + *i );
         }
     }
+
+    // read the models concurrently, see _registerModels()
+    const size_t nCores = std::max( std::thread::hardware_concurrency(), 1u );
+    const size_t nThreads = std::min( _modelFiles.size(), nCores );
+    _nextModelFile = 0;
+    _nLoadingModels = _modelFiles.size();
+    for( size_t i = 0; i < nThreads; ++i )
+        _modelLoaders.push_back( std::thread( &Config::_loadModelFiles, this ));
 }
 
-void Config::_registerModels()
+void Config::_loadModelFiles()
 {
-    for( Model* model : _models )
+    for( ;; )
     {
-        ModelDist* modelDist = new ModelDist( *model, getClient( ));
-        _modelDist.push_back( modelDist );
-        _frameData.setModelID( modelDist->getID( ));
+        const size_t index = _nextModelFile++;
+        if( index >= _modelFiles.size( ))
+            return;
+
+        const std::string& filename = _modelFiles[ index ];
+        Model* model = new Model;
+
+        if( _initData.useInvertedFaces() )
+            model->useInvertedFaces();
+
+        if( !model->readFromFile( filename.c_str( )))
+        {
+            LBWARN << "Can't load model: " << filename << std::endl;
+            delete model;
+            model = 0;
+        }
+
+        {
+            std::lock_guard< std::mutex > mutex( _modelLock );
+            if( model )
+                _loadedModels.push_back( model );
+            --_nLoadingModels;
+        }
+        _modelLoaded.notify_all();
     }
+}
+
+void Config::_joinModelLoaders()
+{
+    for( std::thread& loader : _modelLoaders )
+        loader.join();
+    _modelLoaders.clear();
+    _modelFiles.clear();
+}
+
+void Config::_registerModels()
+{
+    std::unique_lock< std::mutex > mutex( _modelLock );
 
-    if( !_modelDist.empty( ))
+    // wait for the first model in background mode, for all models otherwise
+    while( _nLoadingModels > 0 &&
+           (( _models.empty() && _loadedModels.empty( )) ||
+            !_initData.loadInBackground( )))
     {
-        ModelAssigner assigner( _modelDist );
-        accept( assigner );
+        _modelLoaded.wait( mutex );
     }
+
+    _models.insert( _models.end(), _loadedModels.begin(),
+                    _loadedModels.end( ));
+    _loadedModels.clear();
+
+    // distribute new models and models retained from a previous config run
+    const size_t nAssigned = _modelDist.size();
+    for( size_t i = nAssigned; i < _models.size(); ++i )
+        _modelDist.push_back( new ModelDist( *_models[i], getClient( )));
+
+    if( _modelDist.size() == nAssigned )
+        return;
+
+    if( nAssigned == 0 )
+        _frameData.setModelID( _modelDist.front()->getID( ));
+    ModelAssigner assigner( _modelDist, nAssigned );
+    accept( assigner );
 }
 
 void Config::_deregisterData()
@@ -209,7 +277,7 @@ const Model* Config::getModel( const eq::uint128_t& modelID )
     if( modelID == 0 )
         return 0;
 
-    lunchbox::ScopedWrite _mutex( _modelLock );
+    std::lock_guard< std::mutex > mutex( _modelLock );
 
     const size_t nModels = _models.size();
     LBASSERT( _modelDist.size() == nModels );
@@ -229,6 +297,9 @@ const Model* Config::getModel( const eq::uint128_t& modelID )
 
 uint32_t Config::startFrame()
 {
+    if( _initData.loadInBackground( ))
+        _registerModels(); // distribute and assign newly loaded models
+
     _updateData();
     const eq::uint128_t& version = _frameData.commit();
 
@@ -291,6 +362,13 @@ uint32_t Config::getAnimationFrame()
     return _animation.getCurrentFrame();
 }
 
+void Config::addStatistic( const eq::Statistic& stat )
+{
+    eq::Config::addStatistic( stat );
+    if( !_initData.getBenchmarkFilename().empty( ))
+        _benchmark.add( stat );
+}
+
 bool Config::_needNewFrame()
 {
     if( _messageTime > 0 )
@@ -814,28 +892,33 @@ void Config::_switchView()
 
 void Config::_switchModel()
 {
-    if( _modelDist.empty( )) // no models
-        return;
-
     // current model of current view
     View* view = _getCurrentView();
     const eq::uint128_t& currentID = view ? view->getModelID() :
                                             _frameData.getModelID();
-    // next model
-    ModelDistsCIter i;
-    for( i = _modelDist.begin(); i != _modelDist.end(); ++i )
+    eq::uint128_t modelID;
     {
-        if( (*i)->getID() != currentID )
-            continue;
+        // models loaded in the background are added by startFrame
+        std::lock_guard< std::mutex > mutex( _modelLock );
+        if( _modelDist.empty( )) // no models
+            return;
+
+        // next model
+        ModelDistsCIter i;
+        for( i = _modelDist.begin(); i != _modelDist.end(); ++i )
+        {
+            if( (*i)->getID() != currentID )
+                continue;
 
-        ++i;
-        break;
+            ++i;
+            break;
+        }
+        if( i == _modelDist.end( ))
+            i = _modelDist.begin(); // wrap around
+        modelID = (*i)->getID();
     }
-    if( i == _modelDist.end( ))
-        i = _modelDist.begin(); // wrap around
 
     // set identifier on view or frame data (default model)
-    const eq::uint128_t& modelID = (*i)->getID();
     if( view )
         view->setModelID( modelID );
     else
@@ -32,6 +32,7 @@
 #define EQ_PLY_CONFIG_H
 
 // members
+#include "benchmark.h"
 #include "localInitData.h"
 #include "frameData.h"
 #include "cameraAnimation.h"
@@ -39,6 +40,10 @@
 #include <eq/eq.h>
 #include <eq/admin/base.h>
 
+#include <atomic>
+#include <condition_variable>
+#include <thread>
+
 namespace eqPly
 {
 /**
@@ -87,6 +92,13 @@ public:
     /** @return the current animation frame number. */
     uint32_t getAnimationFrame();
 
+    /** @return the number of frames of the camera path, or 0. */
+    uint32_t getNumAnimationFrames() const
+        { return _animation.getNumFrames(); }
+
+    /** @sa eq::Config::addStatistic */
+    void addStatistic( const eq::Statistic& stat ) override;
+
 protected:
     virtual ~Config();
 
@@ -106,7 +118,16 @@ private:
     ModelDists _modelDist;
     std::mutex  _modelLock;
 
+    // parallel model loading
+    Models _loadedModels; // read, not yet distributed, protected by _modelLock
+    eq::Strings _modelFiles;
+    std::atomic< size_t > _nextModelFile;
+    size_t _nLoadingModels; // protected by _modelLock
+    std::condition_variable _modelLoaded;
+    std::vector< std::thread > _modelLoaders;
+
     CameraAnimation _animation;
+    Benchmark _benchmark;
 
     uint64_t _messageTime;
 
@@ -118,6 +139,8 @@ private:
     eq::admin::ServerPtr _admin;
 
     void _loadModels();
+    void _loadModelFiles();
+    void _joinModelLoaders();
     void _registerModels();
     void _loadPath();
     void _deregisterData();
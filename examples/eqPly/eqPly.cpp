@@ -117,6 +117,16 @@ int EqPly::run()
 
     // 4. run main loop
     uint32_t maxFrames = _initData.getMaxFrames();
+    if( !_initData.getBenchmarkFilename().empty() && maxFrames == 0xffffffffu )
+    {
+        maxFrames = config->getNumAnimationFrames();
+        if( maxFrames == 0 )
+        {
+            LBWARN << "Benchmark without camera path, run until exit"
+                   << std::endl;
+            maxFrames = 0xffffffffu;
+        }
+    }
     int lastFrame = 0;
 
     clock.reset();
@@ -48,6 +48,7 @@ LocalInitData::LocalInitData()
     , _maxFrames( 0xffffffffu )
     , _color( true )
     , _isResident( false )
+    , _background( false )
 {
     _filenames.push_back( lunchbox::getRootPath() +
                           "/share/Equalizer/data" );
@@ -58,8 +59,10 @@ LocalInitData& LocalInitData::operator = ( const LocalInitData& from )
     _maxFrames   = from._maxFrames;
     _color       = from._color;
     _isResident  = from._isResident;
+    _background  = from._background;
     _filenames    = from._filenames;
     _pathFilename = from._pathFilename;
+    _benchmarkFilename = from._benchmarkFilename;
 
     setWindowSystem( from.getWindowSystem( ));
     setRenderMode( from.getRenderMode( ));
@@ -132,12 +135,19 @@ void LocalInitData::parseArguments( const int argc, char** argv )
           "Invert faces (valid during binary file creation)" )
         ( "cameraPath,a", po::value<std::string>(&_pathFilename),
           "File containing camera path animation" )
+        ( "benchmark", po::value<std::string>(&_benchmarkFilename),
+          "Write the per-frame and percentile stage times to the given CSV "
+          "file; replays the camera path once unless numFrames is given" )
         ( "noOverlay,o",
           po::bool_switch(&userDefinedDisableLogo)->default_value( false ),
           "Disable overlay logo" )
         ( "disableROI,d",
           po::bool_switch(&userDefinedDisableROI)->default_value( false ),
-          "Disable region of interest (ROI)" );
+          "Disable region of interest (ROI)" )
+        ( "backgroundLoad",
+          po::bool_switch(&_background)->default_value( false ),
+          "Start rendering with the first loaded model, load the others in "
+          "the background" );
 
     po::variables_map variableMap;
 
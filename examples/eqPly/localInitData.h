@@ -47,9 +47,12 @@ namespace eqPly
         void parseArguments( const int argc, char** argv );
 
         const std::string& getPathFilename() const { return _pathFilename; }
+        const std::string& getBenchmarkFilename() const
+            { return _benchmarkFilename; }
         uint32_t           getMaxFrames()    const { return _maxFrames; }
         bool               useColor()        const { return _color; }
         bool               isResident()      const { return _isResident; }
+        bool               loadInBackground() const { return _background; }
 
         const std::vector< std::string >& getFilenames() const
             { return _filenames; }
@@ -59,9 +62,11 @@ namespace eqPly
     private:
         eq::Strings _filenames;
         std::string _pathFilename;
+        std::string _benchmarkFilename;
         uint32_t    _maxFrames;
         bool        _color;
         bool        _isResident;
+        bool        _background;
     };
 }
 
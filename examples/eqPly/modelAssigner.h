@@ -31,28 +31,37 @@
 
 namespace eqPly
 {
-/** Helper to assign models to views. */
+/**
+ * Helper to assign models to views.
+ *
+ * Models are assigned round-robin. When reassigning after new models were
+ * added, only views still using the model of the previous assignment are
+ * changed, i.e., models selected by the user are kept.
+ */
 class ModelAssigner : public eq::ConfigVisitor
 {
 public:
-    ModelAssigner( const ModelDists& models )
-            : _models( models ), _current( models.begin( )) {}
+    ModelAssigner( const ModelDists& models, const size_t nAssigned = 0 )
+            : _models( models ), _nAssigned( nAssigned ), _index( 0 ) {}
 
     virtual eq::VisitorResult visit( eq::View* view )
         {
-            const ModelDist* model = *_current;
-            static_cast< View* >( view )->setModelID( model->getID( ));
-
-            ++_current;
-            if( _current == _models.end( ))
-                _current = _models.begin(); // wrap around
+            View* plyView = static_cast< View* >( view );
+            const ModelDist* model = _models[ _index % _models.size() ];
+            if( _nAssigned == 0 ||
+                plyView->getModelID() == _models[_index % _nAssigned]->getID( ))
+            {
+                plyView->setModelID( model->getID( ));
+            }
 
+            ++_index;
             return eq::TRAVERSE_CONTINUE;
         }
 
 private:
-    const ModelDists&          _models;
-    ModelDists::const_iterator _current;
+    const ModelDists& _models;
+    const size_t      _nAssigned;
+    size_t            _index;
 };
 
 }
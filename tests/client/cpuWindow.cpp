@@ -0,0 +1,184 @@
+/* Copyright (c) 2016, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Runs headless sort-first and sort-last configs on in-memory windows, using
+// the default readback and assembly of eq::Channel, and compares the result
+// with a single channel rendering.
+
+#include <lunchbox/test.h>
+#include <eq/eq.h>
+#include <eq/cpu/window.h>
+
+#include <algorithm>
+#include <fstream>
+
+namespace
+{
+static const int32_t SIZE = 64; // destination size in pixels
+static const size_t NBOXES = 8;
+
+class Pipe : public eq::Pipe
+{
+public:
+    explicit Pipe( eq::Node* parent ) : eq::Pipe( parent ) {}
+
+protected:
+    eq::MessagePump* createMessagePump() final { return 0; }
+    eq::WindowSystem selectWindowSystem() const final
+        { return eq::WindowSystem( "CPU" ); }
+};
+
+class Channel : public eq::Channel
+{
+public:
+    explicit Channel( eq::Window* parent ) : eq::Channel( parent ) {}
+
+protected:
+    void frameClear( const eq::uint128_t& ) final
+    {
+        _getCPUWindow()->clear( getPixelViewport(),
+                                eq::Vector4ub( 0, 0, 0, 255 ));
+    }
+
+    // overlapping boxes in destination pixels, later boxes are in front
+    void frameDraw( const eq::uint128_t& ) final
+    {
+        const eq::PixelViewport& pvp = getPixelViewport();
+        const eq::Viewport& vp = getViewport();
+        const eq::Range& range = getRange();
+        const size_t begin = size_t( range.start * NBOXES + .5f );
+        const size_t end = size_t( range.end * NBOXES + .5f );
+        const int32_t x = pvp.x - int32_t( vp.x * SIZE + .5f );
+        const int32_t y = pvp.y - int32_t( vp.y * SIZE + .5f );
+
+        for( size_t i = begin; i < end; ++i )
+        {
+            const int32_t pos = 4 + 6 * int32_t( i );
+            eq::PixelViewport box( x + pos, y + pos, 16, 16 );
+            box.intersect( pvp );
+
+            const uint32_t depth = eq::cpu::Window::FAR_DEPTH /
+                                   ( NBOXES + 1 ) * uint32_t( NBOXES - i );
+            const eq::Vector4ub color( uint8_t( 32 * i ), 128,
+                                       uint8_t( 255 - 32 * i ), 255 );
+            _getCPUWindow()->fill( box, color, depth );
+        }
+    }
+
+private:
+    eq::cpu::Window* _getCPUWindow()
+    {
+        return static_cast< eq::cpu::Window* >(
+            getWindow()->getSystemWindow( ));
+    }
+};
+
+class NodeFactory : public eq::NodeFactory
+{
+public:
+    eq::Pipe* createPipe( eq::Node* parent ) final
+        { return new Pipe( parent ); }
+    eq::Channel* createChannel( eq::Window* parent ) final
+        { return new Channel( parent ); }
+};
+
+// A destination and a source window, the compound decomposes the destination
+std::string _createConfig( const std::string& name,
+                           const std::string& compound )
+{
+    const std::string filename = "cpuWindow." + name + ".eqc";
+    std::ofstream file( filename.c_str( ));
+    file << "#Equalizer 1.2 ascii\nserver\n{\n"
+         << "  connection { hostname \"127.0.0.1\" }\n  config\n  {\n"
+         << "    appNode\n    {\n      pipe\n      {\n"
+         << "        window { viewport [ 0 0 " << SIZE << " " << SIZE << " ]"
+         << " channel { name \"destination\" }}\n"
+         << "        window { viewport [ 0 0 " << SIZE << " " << SIZE << " ]"
+         << " channel { name \"source\" }}\n"
+         << "      }\n    }\n"
+         << "    compound\n    {\n      channel \"destination\"\n"
+         << "      wall { bottom_left  [ -.32 -.20 -.75 ]\n"
+         << "             bottom_right [  .32 -.20 -.75 ]\n"
+         << "             top_left     [ -.32  .20 -.75 ] }\n"
+         << compound << "    }\n  }\n}\n";
+    return filename;
+}
+
+// @return the RGB destination pixels after one frame of the given config
+std::vector< uint8_t > _render( const std::string& filename, const int argc,
+                                char** argv )
+{
+    eq::Global::setConfig( filename );
+
+    eq::ClientPtr client = new eq::Client;
+    TEST( client->initLocal( argc, argv ));
+
+    eq::ServerPtr server = new eq::Server;
+    TEST( client->connectServer( server ));
+
+    eq::fabric::ConfigParams configParams;
+    eq::Config* config = server->chooseConfig( configParams );
+    TEST( config );
+    TESTINFO( config->init( eq::uint128_t( )), filename );
+
+    config->startFrame( eq::uint128_t( ));
+    config->finishAllFrames();
+
+    std::vector< uint8_t > pixels;
+    eq::Channel* channel = config->find< eq::Channel >( "destination" );
+    TEST( channel );
+    const eq::cpu::Window* window = static_cast< const eq::cpu::Window* >(
+        channel->getWindow()->getSystemWindow( ));
+    const uint8_t* color = window->getColorBuffer();
+    for( int32_t i = 0; i < SIZE * SIZE; ++i )
+        pixels.insert( pixels.end(), color + i * 4, color + i * 4 + 3 );
+
+    TEST( config->exit( ));
+    server->releaseConfig( config );
+    TEST( client->disconnectServer( server ));
+    client->exitLocal();
+    return pixels;
+}
+}
+
+int main( const int argc, char** argv )
+{
+    NodeFactory nodeFactory;
+    TEST( eq::init( argc, argv, &nodeFactory ));
+
+    const std::vector< uint8_t > reference =
+        _render( _createConfig( "1", "" ), argc, argv );
+    TEST( std::count( reference.begin(), reference.end(), 0 ) <
+          std::ptrdiff_t( reference.size( )));
+
+    const std::vector< uint8_t > db = _render( _createConfig( "DB",
+        "      buffer [ COLOR DEPTH ]\n"
+        "      compound { range [ 0 .5 ] }\n"
+        "      compound { channel \"source\" range [ .5 1 ]\n"
+        "                 outputframe { name \"frame.source\" }}\n"
+        "      inputframe { name \"frame.source\" }\n" ), argc, argv );
+    TEST( db == reference );
+
+    const std::vector< uint8_t > twoD = _render( _createConfig( "2D",
+        "      compound { viewport [ 0 0 .5 1 ] }\n"
+        "      compound { channel \"source\" viewport [ .5 0 .5 1 ]\n"
+        "                 outputframe { name \"frame.source\" }}\n"
+        "      inputframe { name \"frame.source\" }\n" ), argc, argv );
+    TEST( twoD == reference );
+
+    TEST( eq::exit( ));
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,66 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Tests the adaptive loss of the image transmission
+
+#include <lunchbox/test.h>
+#include <eq/transmitQuality.h>
+
+namespace
+{
+const int64_t interval = 100; // ms per frame
+const int64_t busy = 95;
+const int64_t idle = 40;
+const int64_t balanced = 70;
+}
+
+int main( int, char** )
+{
+    eq::TransmitQuality quality;
+    TEST( quality.getLoss() == 0.f );
+    TEST( quality.getQuality( 1.f, .5f ) == 1.f );
+
+    // busy transmission raises the loss by one step per frame, up to 1
+    const float step = eq::TransmitQuality::STEP;
+    TEST( quality.update( true, busy, interval ) == step );
+    TEST( quality.update( true, busy, interval ) == 2.f * step );
+    for( size_t i = 0; i < 10; ++i )
+        quality.update( true, interval, interval );
+    TEST( quality.getLoss() == 1.f );
+    TEST( quality.getQuality( 1.f, .5f ) == .5f );
+    TEST( quality.getQuality( .25f, .5f ) == .25f );
+
+    // balanced transmission keeps the loss
+    TEST( quality.update( true, balanced, interval ) == 1.f );
+
+    // idle transmission lowers the loss by one step per frame, down to 0
+    TEST( quality.update( true, idle, interval ) == 1.f - step );
+    TESTINFO( quality.getQuality( 1.f, .5f ) == .625f,
+              quality.getQuality( 1.f, .5f ));
+    for( size_t i = 0; i < 10; ++i )
+        quality.update( true, 0, interval );
+    TEST( quality.getLoss() == 0.f );
+    TEST( quality.getQuality( 1.f, .5f ) == 1.f );
+
+    // no motion resets to lossless, regardless of the transmission time
+    quality.update( true, busy, interval );
+    quality.update( true, busy, interval );
+    TEST( quality.getLoss() > 0.f );
+    TEST( quality.update( false, busy, interval ) == 0.f );
+    TEST( quality.getQuality( .7f, .5f ) == .7f );
+
+    return EXIT_SUCCESS;
+}
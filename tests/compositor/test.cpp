@@ -21,13 +21,142 @@
 #include <eq/frame.h>
 #include <eq/frameData.h>
 #include <eq/image.h>
+#include <eq/imageOp.h>
 #include <eq/init.h>
 #include <eq/nodeFactory.h>
+#include <eq/pixelData.h>
 #include <eq/fabric/drawableConfig.h>
+#include <eq/fabric/renderContext.h>
 #include <lunchbox/clock.h>
+#include <pression/plugins/compressor.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 
 // Tests the functionality of the compositor and computes the performance.
 
+namespace
+{
+/**
+ * @return the frames blended one after another, from back to front, in
+ *         floating point.
+ */
+std::vector< uint8_t > _blendSequential( const eq::Frames& frames,
+                                         eq::PixelViewport& pvp )
+{
+    pvp = eq::PixelViewport();
+    for( const eq::Frame* frame : frames )
+        for( const eq::Image* image : frame->getImages( ))
+            pvp.merge( image->getPixelViewport() + frame->getOffset( ));
+
+    std::vector< float > blended( pvp.getArea() * 4, 0.f );
+    for( size_t i = 3; i < blended.size(); i += 4 )
+        blended[i] = 1.f;
+
+    for( const eq::Frame* frame : frames )
+    {
+        for( const eq::Image* image : frame->getImages( ))
+        {
+            const eq::PixelViewport imagePVP = image->getPixelViewport() +
+                                               frame->getOffset();
+            const uint8_t* src =
+                image->getPixelPointer( eq::Frame::Buffer::color );
+
+            for( int32_t y = 0; y < imagePVP.h; ++y )
+            {
+                for( int32_t x = 0; x < imagePVP.w; ++x, src += 4 )
+                {
+                    float* dest = &blended[ 4 *
+                        ( size_t( imagePVP.y - pvp.y + y ) * pvp.w +
+                          imagePVP.x - pvp.x + x )];
+                    const float alpha = src[3] / 255.f;
+                    for( size_t c = 0; c < 3; ++c )
+                        dest[c] = src[c] / 255.f + alpha * dest[c];
+                    dest[3] = alpha * dest[3];
+                }
+            }
+        }
+    }
+
+    std::vector< uint8_t > pixels( blended.size( ));
+    for( size_t i = 0; i < pixels.size(); ++i )
+        pixels[i] = uint8_t( std::min( blended[i], 1.f ) * 255.f + .5f );
+    return pixels;
+}
+
+/** @return true if the color of the image differs by at most one. */
+bool _equals( const eq::Image* image, const std::vector< uint8_t >& expected )
+{
+    if( image->getPixelDataSize( eq::Frame::Buffer::color ) != expected.size( ))
+        return false;
+
+    const uint8_t* pixels = image->getPixelPointer( eq::Frame::Buffer::color );
+    for( size_t i = 0; i < expected.size(); ++i )
+        if( std::abs( int( pixels[i] ) - int( expected[i] )) > 1 )
+            return false;
+    return true;
+}
+
+/** Set pixels of the given format on a new memory image of the frame data. */
+eq::Image* _newImage( eq::FrameData& data, const uint32_t format,
+                      const uint32_t pixelSize, const eq::PixelViewport& pvp,
+                      void* colors )
+{
+    eq::PixelData pixels;
+    pixels.internalFormat = format;
+    pixels.externalFormat = format;
+    pixels.pixelSize = pixelSize;
+    pixels.pvp = pvp;
+    pixels.pixels = colors;
+
+    eq::Image* image = data.newImage( eq::Frame::TYPE_MEMORY,
+                                      eq::DrawableConfig( ));
+    image->setPixelViewport( pvp );
+    image->setPixelData( eq::Frame::Buffer::color, pixels );
+    return image;
+}
+
+/**
+ * Blend a front over a back slice of N channels of type T per pixel, each
+ * filled with the given pixel, and test the result against the expected pixel.
+ */
+template< class T, size_t N >
+void _testBlend( const uint32_t format, const T ( &back )[N],
+                 const T ( &front )[N], const T ( &expected )[N] )
+{
+    const eq::PixelViewport pvp( 0, 0, 16, 8 );
+    const T* slices[2] = { back, front };
+    std::vector< T > colors[2];
+    eq::Frame frames[2];
+    eq::Frames ordered;
+
+    for( size_t i = 0; i < 2; ++i )
+    {
+        for( int32_t j = 0; j < pvp.getArea(); ++j )
+            colors[i].insert( colors[i].end(), slices[i], slices[i] + N );
+
+        eq::FrameDataPtr data = new eq::FrameData;
+        data->setBuffers( eq::Frame::Buffer::color );
+        frames[i].setFrameData( data );
+        TEST( _newImage( *data, format, N * sizeof( T ), pvp,
+                         colors[i].data( ))->hasAlpha( ));
+        ordered.push_back( &frames[i] );
+    }
+
+    const eq::Image* result = eq::Compositor::mergeFramesCPU( ordered, true );
+    TEST( result );
+    TEST( result->getPixelViewport() == pvp );
+    TEST( result->getExternalFormat( eq::Frame::Buffer::color ) == format );
+
+    const T* pixels = reinterpret_cast< const T* >(
+        result->getPixelPointer( eq::Frame::Buffer::color ));
+    for( int32_t j = 0; j < pvp.getArea(); ++j )
+        TESTINFO( ::memcmp( pixels + j * N, expected, sizeof( expected )) == 0,
+                  format << " pixel " << j );
+}
+}
+
 int main( int, char **argv )
 {
     eq::NodeFactory nodeFactory;
@@ -187,6 +316,472 @@ int main( int, char **argv )
     std::cout << argv[0] << ": Alpha 15 images: " << time << " ms ("
          << 5000.0f * size / time / 1024.0f / 1024.0f << " MB/s)" << std::endl;
 
+    // 4) ordered alpha-blend assembly test, one slice per frame
+    eq::Frame slices[3];
+    const char* sliceNames[3] = { "Image_15_color.rgb", "Image_14_color.rgb",
+                                  "Image_13_color.rgb" };
+    frames.clear();
+    for( size_t i = 0; i < 3; ++i )
+    {
+        eq::FrameDataPtr sliceData = new eq::FrameData;
+        sliceData->setBuffers( eq::Frame::Buffer::color );
+        slices[i].setFrameData( sliceData );
+
+        image = sliceData->newImage( eq::Frame::TYPE_MEMORY,
+                                     eq::DrawableConfig( ));
+        TEST( image->readImage( sliceNames[i], eq::Frame::Buffer::color ));
+        frames.push_back( &slices[i] );
+    }
+
+    clock.reset();
+    result = eq::Compositor::mergeFramesOrderedCPU( frames );
+    time = clock.getTimef();
+    TEST( result );
+
+    std::cout << argv[0] << ": Ordered alpha: " << time << " ms ("
+         << 1000.0f * size / time / 1024.0f / 1024.0f << " MB/s)" << std::endl;
+
+    result->writeImages( "Result_OrderedAlpha" );
+
+    // The frames are reduced pairwise in the order in which they become ready.
+    // Test that each visibility order yields the sequential blending, and that
+    // blending the images of the frames in the same order does too.
+    size_t order[3] = { 0, 1, 2 };
+    do
+    {
+        frames.clear();
+        for( size_t i : order )
+            frames.push_back( &slices[i] );
+
+        eq::PixelViewport pvp;
+        const std::vector< uint8_t > expected = _blendSequential( frames, pvp );
+
+        result = eq::Compositor::mergeFramesOrderedCPU( frames );
+        TEST( result );
+        TEST( result->getPixelViewport() == pvp );
+        TEST( _equals( result, expected ));
+
+        eq::ImageOps ops;
+        for( const eq::Frame* slice : frames )
+            ops.push_back( eq::ImageOp( slice, slice->getImages().front( )));
+
+        result = eq::Compositor::mergeImagesOrderedCPU( ops );
+        TEST( result );
+        TEST( result->getPixelViewport() == pvp );
+        TEST( _equals( result, expected ));
+    }
+    while( std::next_permutation( order, order + 3 ));
+
+    // an empty slice leaves the other slice unchanged
+    image = slices[0].getImages().front();
+    eq::Frame empty;
+    eq::FrameDataPtr emptyData = new eq::FrameData;
+    emptyData->setBuffers( eq::Frame::Buffer::color );
+    empty.setFrameData( emptyData );
+
+    frames.clear();
+    frames.push_back( &slices[0] );
+    frames.push_back( &empty );
+
+    result = eq::Compositor::mergeFramesOrderedCPU( frames );
+    TEST( result );
+    TEST( result->getPixelViewport() == image->getPixelViewport( ));
+    TEST( ::memcmp( result->getPixelPointer( eq::Frame::Buffer::color ),
+                    image->getPixelPointer( eq::Frame::Buffer::color ),
+                    image->getPixelDataSize( eq::Frame::Buffer::color )) == 0 );
+
+    // 5) HDR DB assembly test, the nearer of two half float images wins
+    const eq::PixelViewport hdrPVP( 0, 0, 64, 64 );
+    const size_t nPixels = hdrPVP.getArea();
+    std::vector< uint64_t > hdrColors[2];
+    std::vector< uint32_t > hdrDepths[2];
+    eq::FrameDataPtr hdrData = new eq::FrameData;
+    hdrData->setBuffers( eq::Frame::Buffer::color | eq::Frame::Buffer::depth );
+    frame.setFrameData( hdrData );
+
+    for( size_t i = 0; i < 2; ++i )
+    {
+        hdrColors[i].resize( nPixels );
+        hdrDepths[i].resize( nPixels );
+        for( size_t j = 0; j < nPixels; ++j )
+        {
+            hdrColors[i][j] = 0x3c00000000000000ull * ( i + 1 ) + j;
+            hdrDepths[i][j] = uint32_t(( j * 7919 + i * 104729 ) % 65521 );
+        }
+
+        eq::PixelData pixels;
+        pixels.internalFormat = EQ_COMPRESSOR_DATATYPE_RGBA16F;
+        pixels.externalFormat = EQ_COMPRESSOR_DATATYPE_RGBA16F;
+        pixels.pixelSize = 8;
+        pixels.pvp = hdrPVP;
+        pixels.pixels = hdrColors[i].data();
+
+        image = hdrData->newImage( eq::Frame::TYPE_MEMORY,
+                                   eq::DrawableConfig( ));
+        image->setPixelViewport( hdrPVP );
+        image->setPixelData( eq::Frame::Buffer::color, pixels );
+
+        pixels.internalFormat = EQ_COMPRESSOR_DATATYPE_DEPTH;
+        pixels.externalFormat = EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT;
+        pixels.pixelSize = 4;
+        pixels.pixels = hdrDepths[i].data();
+        image->setPixelData( eq::Frame::Buffer::depth, pixels );
+    }
+
+    frames.clear();
+    frames.push_back( &frame );
+    result = eq::Compositor::mergeFramesCPU( frames );
+    TEST( result );
+    TEST( result->getPixelViewport() == hdrPVP );
+    TEST( result->getPixelSize( eq::Frame::Buffer::color ) == 8 );
+
+    const uint64_t* hdrResult = reinterpret_cast< const uint64_t* >(
+        result->getPixelPointer( eq::Frame::Buffer::color ));
+    for( size_t j = 0; j < nPixels; ++j )
+    {
+        const size_t nearest = hdrDepths[1][j] < hdrDepths[0][j] ? 1 : 0;
+        TESTINFO( hdrResult[j] == hdrColors[ nearest ][j], j );
+    }
+
+    // 6) CPU accumulation test, averaging two float subpixel steps
+    std::vector< float > steps[2];
+    eq::FrameDataPtr accumData = new eq::FrameData;
+    accumData->setBuffers( eq::Frame::Buffer::color );
+    frame.setFrameData( accumData );
+
+    eq::ImageOps ops;
+    for( uint32_t i = 0; i < 2; ++i )
+    {
+        steps[i].resize( nPixels * 4 );
+        for( size_t j = 0; j < steps[i].size(); ++j )
+            steps[i][j] = float( j % 7 ) * float( i + 1 );
+
+        eq::PixelData pixels;
+        pixels.internalFormat = EQ_COMPRESSOR_DATATYPE_RGBA32F;
+        pixels.externalFormat = EQ_COMPRESSOR_DATATYPE_RGBA32F;
+        pixels.pixelSize = 16;
+        pixels.pvp = hdrPVP;
+        pixels.pixels = steps[i].data();
+
+        eq::RenderContext context;
+        context.subPixel = eq::SubPixel( i, 2 );
+
+        image = accumData->newImage( eq::Frame::TYPE_MEMORY,
+                                     eq::DrawableConfig( ));
+        image->setContext( context );
+        image->setPixelViewport( hdrPVP );
+        image->setPixelData( eq::Frame::Buffer::color, pixels );
+
+        eq::ImageOp op( &frame, image );
+        op.offset = eq::Vector2i( 0, 0 );
+        ops.push_back( op );
+    }
+
+    TEST( eq::Compositor::isSubPixelDecomposition( ops ));
+    result = eq::Compositor::mergeImagesAccumCPU( ops, false );
+    TEST( result );
+    TEST( result->getPixelViewport() == hdrPVP );
+
+    const float* accumResult = reinterpret_cast< const float* >(
+        result->getPixelPointer( eq::Frame::Buffer::color ));
+    for( size_t j = 0; j < nPixels * 4; ++j )
+        TESTINFO( accumResult[j] == float( j % 7 ) * 1.5f, j );
+
+    // a step covering only the left half, the right half is the other step
+    const eq::PixelViewport leftPVP( 0, 0, hdrPVP.w / 2, hdrPVP.h );
+    eq::PixelData leftPixels;
+    leftPixels.internalFormat = EQ_COMPRESSOR_DATATYPE_RGBA32F;
+    leftPixels.externalFormat = EQ_COMPRESSOR_DATATYPE_RGBA32F;
+    leftPixels.pixelSize = 16;
+    leftPixels.pvp = leftPVP;
+    leftPixels.pixels = steps[1].data();
+    image->setPixelViewport( leftPVP );
+    image->setPixelData( eq::Frame::Buffer::color, leftPixels );
+
+    result = eq::Compositor::mergeImagesAccumCPU( ops, false );
+    TEST( result );
+    TEST( result->getPixelViewport() == hdrPVP );
+
+    accumResult = reinterpret_cast< const float* >(
+        result->getPixelPointer( eq::Frame::Buffer::color ));
+    for( int32_t y = 0; y < hdrPVP.h; ++y )
+    {
+        for( int32_t x = 0; x < hdrPVP.w; ++x )
+        {
+            for( size_t c = 0; c < 4; ++c )
+            {
+                const size_t j = ( size_t( y ) * hdrPVP.w + x ) * 4 + c;
+                const size_t k = ( size_t( y ) * leftPVP.w + x ) * 4 + c;
+                const float expected = x < leftPVP.w ?
+                    ( steps[0][j] + steps[1][k] ) * .5f : steps[0][j];
+                TESTINFO( accumResult[j] == expected, j );
+            }
+        }
+    }
+
+    // 7) Pixel assembly test, two images interleaved column by column
+    const eq::PixelViewport halfPVP( 0, 0, hdrPVP.w / 2, hdrPVP.h );
+    std::vector< uint32_t > columns[2];
+    eq::FrameDataPtr pixelData = new eq::FrameData;
+    pixelData->setBuffers( eq::Frame::Buffer::color );
+    frame.setFrameData( pixelData );
+
+    for( uint32_t i = 0; i < 2; ++i )
+    {
+        columns[i].resize( halfPVP.getArea( ));
+        for( size_t j = 0; j < columns[i].size(); ++j )
+            columns[i][j] = uint32_t( j * 2 + i ) | 0xff000000u;
+
+        eq::PixelData pixels;
+        pixels.internalFormat = EQ_COMPRESSOR_DATATYPE_RGBA;
+        pixels.externalFormat = EQ_COMPRESSOR_DATATYPE_RGBA;
+        pixels.pixelSize = 4;
+        pixels.pvp = halfPVP;
+        pixels.pixels = columns[i].data();
+
+        eq::RenderContext context;
+        context.pixel = eq::Pixel( i, 0, 2, 1 );
+
+        image = pixelData->newImage( eq::Frame::TYPE_MEMORY,
+                                     eq::DrawableConfig( ));
+        image->setContext( context );
+        image->setPixelViewport( halfPVP );
+        image->setPixelData( eq::Frame::Buffer::color, pixels );
+    }
+
+    frames.clear();
+    frames.push_back( &frame );
+    result = eq::Compositor::mergeFramesCPU( frames );
+    TEST( result );
+    TEST( result->getPixelViewport() == hdrPVP );
+
+    const uint32_t* pixelResult = reinterpret_cast< const uint32_t* >(
+        result->getPixelPointer( eq::Frame::Buffer::color ));
+    for( size_t j = 0; j < nPixels; ++j )
+        TESTINFO( pixelResult[j] == ( uint32_t( j ) | 0xff000000u ), j );
+
+    // 8) Sparse assembly test, only the areas around distant images. The
+    // first two images share a tile, the last one is not tile-aligned.
+    const eq::PixelViewport smallPVP( 0, 0, 16, 16 );
+    const eq::Vector2i sparseOffsets[3] = { eq::Vector2i( 0, 0 ),
+                                            eq::Vector2i( 20, 30 ),
+                                            eq::Vector2i( 500, 250 ) };
+    std::vector< uint32_t > smallColors( smallPVP.getArea(), 0xff0000ffu );
+    eq::FrameDataPtr sparseData = new eq::FrameData;
+    sparseData->setBuffers( eq::Frame::Buffer::color );
+    frame.setFrameData( sparseData );
+
+    ops.clear();
+    for( size_t i = 0; i < 3; ++i )
+    {
+        eq::PixelData pixels;
+        pixels.internalFormat = EQ_COMPRESSOR_DATATYPE_RGBA;
+        pixels.externalFormat = EQ_COMPRESSOR_DATATYPE_RGBA;
+        pixels.pixelSize = 4;
+        pixels.pvp = smallPVP;
+        pixels.pixels = smallColors.data();
+
+        image = sparseData->newImage( eq::Frame::TYPE_MEMORY,
+                                      eq::DrawableConfig( ));
+        image->setPixelViewport( smallPVP );
+        image->setPixelData( eq::Frame::Buffer::color, pixels );
+
+        eq::ImageOp op( &frame, image );
+        op.offset = sparseOffsets[i];
+        ops.push_back( op );
+    }
+
+    // the regions are cropped to the images, not to the 64 pixel tiles
+    const eq::Images sparse = eq::Compositor::mergeImagesSparseCPU( ops,
+                                                                    false );
+    TEST( sparse.size() == 2 );
+    TEST( sparse[0]->getPixelViewport() == eq::PixelViewport( 0, 0, 36, 46 ));
+    TEST( sparse[1]->getPixelViewport() == smallPVP + sparseOffsets[2] );
+
+    const uint32_t* sparseColors = reinterpret_cast< const uint32_t* >(
+        sparse[0]->getPixelPointer( eq::Frame::Buffer::color ));
+    for( int32_t y = 0; y < 46; ++y )
+    {
+        for( int32_t x = 0; x < 36; ++x )
+        {
+            const bool covered = ( x < 16 && y < 16 ) ||
+                                 ( x >= 20 && y >= 30 );
+            TEST( sparseColors[ y * 36 + x ] ==
+                  ( covered ? 0xff0000ffu : 0xff000000u ));
+        }
+    }
+
+    sparseColors = reinterpret_cast< const uint32_t* >(
+        sparse[1]->getPixelPointer( eq::Frame::Buffer::color ));
+    for( int32_t j = 0; j < smallPVP.getArea(); ++j )
+        TEST( sparseColors[j] == 0xff0000ffu );
+
+    // 9) Packed DB image test, only the segments off the far plane are kept
+    const eq::PixelViewport packPVP( 0, 0, 40, 4 );
+    std::vector< uint32_t > packColors( packPVP.getArea( ));
+    std::vector< uint32_t > packDepths( packPVP.getArea(), 0xffffffffu );
+    for( size_t j = 0; j < packColors.size(); ++j )
+        packColors[j] = uint32_t( j ) | 0xff000000u;
+    packDepths[ 1 ] = 42;                 // first segment of the first row
+    packDepths[ 2 * packPVP.w + 35 ] = 7; // partial last segment of a row
+
+    eq::FrameDataPtr packData = new eq::FrameData;
+    packData->setBuffers( eq::Frame::Buffer::color | eq::Frame::Buffer::depth );
+    frame.setFrameData( packData );
+
+    eq::PixelData pixels;
+    pixels.internalFormat = EQ_COMPRESSOR_DATATYPE_RGBA;
+    pixels.externalFormat = EQ_COMPRESSOR_DATATYPE_RGBA;
+    pixels.pixelSize = 4;
+    pixels.pvp = packPVP;
+    pixels.pixels = packColors.data();
+
+    image = packData->newImage( eq::Frame::TYPE_MEMORY, eq::DrawableConfig( ));
+    image->setPixelViewport( packPVP );
+    image->setPixelData( eq::Frame::Buffer::color, pixels );
+
+    pixels.internalFormat = EQ_COMPRESSOR_DATATYPE_DEPTH;
+    pixels.externalFormat = EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT;
+    pixels.pixels = packDepths.data();
+    image->setPixelData( eq::Frame::Buffer::depth, pixels );
+
+    TEST( image->updateCoverage() == 2.f / 12.f );
+    TEST( image->getCoverageRatio() == 2.f / 12.f );
+    eq::Image packed;
+    TEST( image->packPixelData( eq::Frame::Buffer::color, packed ));
+    TEST( packed.getPixelViewport() == eq::PixelViewport( 0, 0, 24, 1 ));
+
+    eq::Image unpacked;
+    unpacked.setPixelViewport( packPVP );
+    unpacked.unpackPixelData( eq::Frame::Buffer::color, packed,
+                              image->getCoverage( ));
+    TEST( image->packPixelData( eq::Frame::Buffer::depth, packed ));
+    unpacked.unpackPixelData( eq::Frame::Buffer::depth, packed,
+                              image->getCoverage( ));
+    TEST( unpacked.getCoverage() == image->getCoverage( ));
+    TEST( ::memcmp( unpacked.getPixelPointer( eq::Frame::Buffer::depth ),
+                    packDepths.data(), packDepths.size() * 4 ) == 0 );
+
+    const uint32_t* unpackedColors = reinterpret_cast< const uint32_t* >(
+        unpacked.getPixelPointer( eq::Frame::Buffer::color ));
+    TEST( unpackedColors[ 1 ] == packColors[ 1 ] );
+    TEST( unpackedColors[ 2 * packPVP.w + 39 ] == packColors[ 2*packPVP.w+39 ]);
+    TEST( unpackedColors[ 16 ] == 0xff000000u ); // cleared
+
+    ops.clear();
+    ops.push_back( eq::ImageOp( &frame, &unpacked ));
+    ops.back().offset = eq::Vector2i( 0, 0 );
+    result = eq::Compositor::mergeImagesCPU( ops, false );
+    TEST( result );
+    const uint32_t* packResult = reinterpret_cast< const uint32_t* >(
+        result->getPixelPointer( eq::Frame::Buffer::color ));
+    for( size_t j = 0; j < packColors.size(); ++j )
+        TESTINFO( packResult[j] == ( packDepths[j] == 0xffffffffu ?
+                                     0xff000000u : packColors[j] ), j );
+
+    // 10) HDR and 10 bit blend test, a half transparent front slice over a
+    // half transparent back slice over the cleared background:
+    // color = front + frontAlpha * back, alpha = frontAlpha * backAlpha
+    const float backF[4] = { .5f, .25f, .125f, .5f };
+    const float frontF[4] = { .25f, .5f, 0.f, .5f };
+    const float expectedF[4] = { .5f, .625f, .0625f, .25f };
+    _testBlend( EQ_COMPRESSOR_DATATYPE_RGBA32F, backF, frontF, expectedF );
+
+    const uint16_t backH[4] = { 0x3800, 0x3400, 0x3000, 0x3800 };
+    const uint16_t frontH[4] = { 0x3400, 0x3800, 0x0000, 0x3800 };
+    const uint16_t expectedH[4] = { 0x3800, 0x3900, 0x2c00, 0x3400 };
+    _testBlend( EQ_COMPRESSOR_DATATYPE_RGBA16F, backH, frontH, expectedH );
+
+    // GL_UNSIGNED_INT_10_10_10_2: red in the MSBs, alpha in the two LSBs
+    const uint32_t back10[1] = { 300u << 22 | 600u << 12 | 900u << 2 | 1u };
+    const uint32_t front10[1] = { 100u << 22 | 200u << 12 | 1000u << 2 | 2u };
+    const uint32_t expected10[1] = // 2/3 of the back, blue clamped
+        { 300u << 22 | 600u << 12 | 1023u << 2 | 0u };
+    _testBlend( EQ_COMPRESSOR_DATATYPE_RGB10_A2, back10, front10, expected10 );
+
+    // 11) 2D assembly test, a float tile next to a DB image keeps its depth
+    const eq::PixelViewport tilePVP( 0, 0, 8, 8 );
+    std::vector< float > tileColors[2];
+    std::vector< uint32_t > tileDepth( tilePVP.getArea(), 1234u );
+    eq::FrameDataPtr tileData = new eq::FrameData;
+    tileData->setBuffers( eq::Frame::Buffer::color | eq::Frame::Buffer::depth );
+    frame.setFrameData( tileData );
+
+    for( size_t i = 0; i < 2; ++i )
+    {
+        tileColors[i].resize( tilePVP.getArea() * 4 );
+        for( size_t j = 0; j < tileColors[i].size(); ++j )
+            tileColors[i][j] = float( j ) + float( i ) * .5f;
+
+        const eq::PixelViewport pvp = tilePVP + eq::Vector2i( i * 8, 0 );
+        image = _newImage( *tileData, EQ_COMPRESSOR_DATATYPE_RGBA32F, 16, pvp,
+                           tileColors[i].data( ));
+        if( i > 0 )
+            continue;
+
+        // the first tile is a DB image, the second one a 2D tile
+        eq::PixelData depth;
+        depth.internalFormat = EQ_COMPRESSOR_DATATYPE_DEPTH;
+        depth.externalFormat = EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT;
+        depth.pixelSize = 4;
+        depth.pvp = pvp;
+        depth.pixels = tileDepth.data();
+        image->setPixelData( eq::Frame::Buffer::depth, depth );
+    }
+
+    frames.clear();
+    frames.push_back( &frame );
+    result = eq::Compositor::mergeFramesCPU( frames );
+    TEST( result );
+    TEST( result->getPixelViewport() == eq::PixelViewport( 0, 0, 16, 8 ));
+
+    const float* tileResult = reinterpret_cast< const float* >(
+        result->getPixelPointer( eq::Frame::Buffer::color ));
+    const uint32_t* tileResultDepth = reinterpret_cast< const uint32_t* >(
+        result->getPixelPointer( eq::Frame::Buffer::depth ));
+    for( int32_t y = 0; y < 8; ++y )
+    {
+        for( int32_t x = 0; x < 16; ++x )
+        {
+            const size_t tile = x / 8;
+            const size_t j = y * 8 + x % 8;
+            TEST( ::memcmp( tileResult + ( y * 16 + x ) * 4,
+                            tileColors[ tile ].data() + j * 4,
+                            4 * sizeof( float )) == 0 );
+            TESTINFO( tileResultDepth[ y * 16 + x ] == ( tile ? 0u : 1234u ),
+                      x << ", " << y );
+        }
+    }
+
+    // 12) HDR clear test, black with full alpha
+    const uint32_t clearFormats[3] = { EQ_COMPRESSOR_DATATYPE_RGB10_A2,
+                                       EQ_COMPRESSOR_DATATYPE_RGBA16F,
+                                       EQ_COMPRESSOR_DATATYPE_RGBA32F };
+    const uint32_t clearSizes[3] = { 4, 8, 16 };
+    const uint16_t clearHalf[4] = { 0, 0, 0, 0x3c00 };
+    const float clearFloat[4] = { 0.f, 0.f, 0.f, 1.f };
+    const uint32_t clear10 = 0x3u;
+    const void* clearPixels[3] = { &clear10, clearHalf, clearFloat };
+
+    for( size_t i = 0; i < 3; ++i )
+    {
+        eq::Image cleared;
+        pixels.internalFormat = clearFormats[i];
+        pixels.externalFormat = clearFormats[i];
+        pixels.pixelSize = clearSizes[i];
+        pixels.pvp = tilePVP;
+        pixels.pixels = 0;
+        cleared.setPixelViewport( tilePVP );
+        cleared.setPixelData( eq::Frame::Buffer::color, pixels ); // clears
+
+        const uint8_t* data =
+            cleared.getPixelPointer( eq::Frame::Buffer::color );
+        for( int32_t j = 0; j < tilePVP.getArea(); ++j )
+            TESTINFO( ::memcmp( data + j * clearSizes[i], clearPixels[i],
+                                clearSizes[i] ) == 0,
+                      clearFormats[i] << " pixel " << j );
+    }
+
     TEST( eq::exit( ));
 
     return EXIT_SUCCESS;
@@ -0,0 +1,226 @@
+/* Copyright (c) 2016, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#define TEST_RUNTIME 600 // seconds
+#include <lunchbox/test.h>
+
+#include <eq/disseminationBarrier.h>
+#include <eq/fabric/commands.h>
+
+#include <co/barrier.h>
+#include <co/connectionDescription.h>
+#include <co/init.h>
+#include <co/localNode.h>
+#include <co/object.h>
+#include <co/objectICommand.h>
+
+#include <lunchbox/clock.h>
+#include <lunchbox/thread.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+
+// Measures the latency of the centralized co::Barrier and of the
+// eq::DisseminationBarrier used by eq::Window for large swap barrier groups.
+// Each participant is a co::LocalNode in its own thread, connected to the
+// others over TCP.
+// Usage: barrier [maxParticipants]
+
+namespace
+{
+static const uint32_t ITERATIONS = 1000;
+static const uint32_t TIMEOUT = 10000; // ms
+
+/** Receives the dissemination rounds, like eq::Node does */
+class Participant : public co::Object
+{
+public:
+    co::LocalNodePtr node;
+    eq::DisseminationBarrier barrier;
+
+protected:
+    void attach( const uint128_t& id, const uint32_t instanceID ) override
+    {
+        co::Object::attach( id, instanceID );
+        registerCommand( eq::fabric::CMD_NODE_BARRIER_SIGNAL,
+                         co::CommandFunc< Participant >(
+                             this, &Participant::_cmdBarrierSignal ), 0 );
+    }
+
+    void getInstanceData( co::DataOStream& ) override { LBDONTCALL }
+    void applyInstanceData( co::DataIStream& ) override { LBDONTCALL }
+
+private:
+    bool _cmdBarrierSignal( co::ICommand& cmd )
+    {
+        co::ObjectICommand command( cmd );
+        const uint128_t& id = command.read< uint128_t >();
+        const uint32_t rank = command.read< uint32_t >();
+        const uint32_t round = command.read< uint32_t >();
+        barrier.signal( id, rank, round );
+        return true;
+    }
+};
+typedef std::vector< Participant* > Participants;
+
+class Runner : public lunchbox::Thread
+{
+public:
+    Runner( Participants& participants, const size_t rank,
+            const co::ObjectVersion& barrier )
+        : time( 0.f ), _participants( participants ), _rank( rank )
+        , _barrier( barrier )
+    {}
+
+    float time; // per iteration in ms
+
+protected:
+    void run() override
+    {
+        Participant* self = _participants[ _rank ];
+        if( _barrier.identifier == 0 )
+            _runDissemination( self );
+        else
+            _runCentral( self );
+    }
+
+private:
+    Participants& _participants;
+    const size_t _rank;
+    const co::ObjectVersion _barrier;
+
+    void _runCentral( Participant* self )
+    {
+        co::Barrier barrier( self->node, _barrier );
+        TEST( barrier.isGood( ));
+        TEST( barrier.enter( TIMEOUT )); // warmup, connects all
+
+        const lunchbox::Clock clock;
+        for( size_t i = 0; i < ITERATIONS; ++i )
+            TEST( barrier.enter( TIMEOUT ));
+        time = clock.getTimef() / float( ITERATIONS );
+    }
+
+    void _runDissemination( Participant* self )
+    {
+        // the peers signaled in each round, see server::Window
+        const size_t size = _participants.size();
+        std::vector< uint128_t > objects;
+        co::NodeIDs netNodes;
+        std::vector< uint32_t > ranks;
+        for( size_t distance = 1; distance < size; distance <<= 1 )
+        {
+            const size_t rank = ( _rank + distance ) % size;
+            const Participant* peer = _participants[ rank ];
+            objects.push_back( peer->getID( ));
+            netNodes.push_back( peer->node->getNodeID( ));
+            ranks.push_back( uint32_t( rank ));
+        }
+
+        // warmup, connects all peers
+        TEST( self->barrier.enter( self->node, uint128_t( 0, 0 ),
+                                   uint32_t( _rank ), objects, netNodes, ranks,
+                                   TIMEOUT ));
+
+        const lunchbox::Clock clock;
+        for( uint32_t i = 1; i <= ITERATIONS; ++i )
+            TEST( self->barrier.enter( self->node, uint128_t( 0, i ),
+                                       uint32_t( _rank ), objects, netNodes,
+                                       ranks, TIMEOUT ));
+        time = clock.getTimef() / float( ITERATIONS );
+    }
+};
+
+float _run( Participants& participants, const co::ObjectVersion& barrier )
+{
+    std::vector< Runner* > runners;
+    for( size_t i = 0; i < participants.size(); ++i )
+    {
+        runners.push_back( new Runner( participants, i, barrier ));
+        TEST( runners.back()->start( ));
+    }
+
+    float time = 0.f;
+    for( Runner* runner : runners )
+    {
+        TEST( runner->join( ));
+        time = std::max( time, runner->time );
+        delete runner;
+    }
+    return time;
+}
+}
+
+int main( int argc, char **argv )
+{
+    TEST( co::init( argc, argv ));
+    const size_t maxParticipants = argc > 1 ? ::atoi( argv[1] ) : 32;
+
+    std::cout.setf( std::ios::right, std::ios::adjustfield );
+    std::cout.precision( 5 );
+    std::cout << "PARTICIPANTS,  t_central, t_dissemination" << std::endl;
+
+    for( size_t size = 2; size <= maxParticipants; size <<= 1 )
+    {
+        Participants participants;
+        for( size_t i = 0; i < size; ++i )
+        {
+            Participant* participant = new Participant;
+            participant->node = new co::LocalNode;
+            participant->node->addConnectionDescription(
+                new co::ConnectionDescription );
+            TEST( participant->node->initLocal( argc, argv ));
+            TEST( participant->node->registerObject( participant ));
+            participants.push_back( participant );
+        }
+
+        // connect all to the first node, which resolves all other nodes
+        const co::ConnectionDescriptions& descriptions =
+            participants.front()->node->getConnectionDescriptions();
+        for( size_t i = 1; i < size; ++i )
+        {
+            co::NodePtr proxy = new co::Node;
+            proxy->addConnectionDescription( descriptions.front( ));
+            TEST( participants[i]->node->connect( proxy ));
+        }
+
+        // centralized barrier, master on the first node
+        co::LocalNodePtr master = participants.front()->node;
+        co::Barrier* barrier = new co::Barrier( master, master->getNodeID(),
+                                                uint32_t( size ));
+        const float centralTime = _run( participants,
+                                        co::ObjectVersion( barrier ));
+        delete barrier;
+
+        const float disseminationTime = _run( participants,
+                                              co::ObjectVersion( ));
+
+        std::cout << std::setw(12) << size << ", " << std::setw(10)
+                  << centralTime << ", " << std::setw(15) << disseminationTime
+                  << std::endl;
+
+        for( Participant* participant : participants )
+        {
+            participant->node->deregisterObject( participant );
+            TEST( participant->node->exitLocal( ));
+            delete participant;
+        }
+    }
+
+    TEST( co::exit( ));
+    return EXIT_SUCCESS;
+}
@@ -23,6 +23,7 @@
 #include <eq/init.h>
 #include <eq/nodeFactory.h>
 #include <eq/pixelData.h>
+#include <eq/compressor/compressorDepth.h> // EQ_COMPRESSOR_DEPTH_PREDICT
 
 #include <co/global.h>
 
@@ -34,8 +35,10 @@
 #include <pression/pluginVisitor.h>
 #include <pression/plugins/compressor.h>
 
+#include <algorithm>
 #include <numeric>
 #include <fstream>
+#include <vector>
 
 // Tests the functionality and speed of the image compression.
 //#define WRITE_DECOMPRESSED
@@ -89,6 +92,179 @@ static void _compare( const void* data, const void* destData,
               "Comparison of initial data and decompressed data failed" <<
               ", error " << error << " max " << max );
 }
+
+// A depth buffer as read back in a DB compound: a tilted plane covering a disc
+// of the given radius, on a far plane background
+std::vector< uint32_t > _createDepth( const int32_t width, const int32_t height,
+                                      const float radius )
+{
+    std::vector< uint32_t > depth( size_t( width ) * height, 0xffffffffu );
+    const float r2 = radius * radius * width * height;
+    size_t i = 0;
+    for( int32_t y = 0; y < height; ++y )
+    {
+        for( int32_t x = 0; x < width; ++x, ++i )
+        {
+            const float dx = float( x - width / 2 );
+            const float dy = float( y - height / 2 );
+            if( dx * dx + dy * dy < r2 )
+                depth[ i ] = 0x80000000u + uint32_t( x ) * 4099u +
+                             uint32_t( y ) * 1031u;
+        }
+    }
+    return depth;
+}
+
+// Tests the depth compressors of the Equalizer plugin exactly: the far plane
+// is always kept, the lossy one has an error of at most half its dropped bits
+void _compareDepth( const std::vector< uint32_t >& data,
+                    const uint32_t* destData, const uint32_t maxError )
+{
+    for( size_t i = 0; i < data.size(); ++i )
+    {
+        if( data[i] == 0xffffffffu )
+        {
+            TESTINFO( destData[i] == 0xffffffffu, "pixel " << i );
+            continue;
+        }
+        const uint32_t error = data[i] > destData[i] ? data[i] - destData[i] :
+                                                       destData[i] - data[i];
+        TESTINFO( error <= maxError && destData[i] != 0xffffffffu,
+                  "pixel " << i << ": " << data[i] << " != " << destData[i] );
+    }
+}
+
+// Reports ratio and throughput of the depth compressors on a synthetic image
+void _testDepth( const std::vector< uint32_t >& names,
+                 const eq::PixelViewport& pvp,
+                 const std::vector< uint32_t >& data )
+{
+    const float coverage = float( data.size() -
+                                  std::count( data.begin(), data.end(),
+                                              0xffffffffu )) /
+                           float( data.size( ));
+    const auto& registry = pression::PluginRegistry::getInstance();
+    const eq::Frame::Buffer buffer = eq::Frame::Buffer::depth;
+    lunchbox::Clock clock;
+
+    eq::PixelData pixels;
+    pixels.internalFormat = EQ_COMPRESSOR_DATATYPE_DEPTH;
+    pixels.externalFormat = EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT;
+    pixels.pixelSize = 4;
+    pixels.pvp = pvp;
+    pixels.pixels = const_cast< uint32_t* >( data.data( ));
+
+    eq::Image image;
+    eq::Image destImage;
+    image.setPixelViewport( pvp );
+    image.setInternalFormat( buffer, EQ_COMPRESSOR_DATATYPE_DEPTH );
+    image.setPixelData( buffer, pixels );
+    const std::vector< uint32_t > compressors = image.findCompressors( buffer );
+    const uint32_t size = image.getPixelDataSize( buffer );
+
+    for( const uint32_t name : names )
+    {
+        if( std::find( compressors.begin(), compressors.end(), name ) ==
+            compressors.end( ))
+        {
+            continue;
+        }
+
+        image.allocCompressor( buffer, name );
+        destImage.setPixelViewport( pvp );
+
+        clock.reset();
+        const eq::PixelData& compressed = image.compressPixelData( buffer );
+        const float compressTime = clock.getTimef();
+        TEST( compressed.compressedData.compressor == name );
+
+        clock.reset();
+        destImage.setPixelData( buffer, compressed );
+        const float decompressTime = clock.getTimef();
+
+        const uint32_t compressedSize = compressed.compressedData.getSize();
+        const float quality =
+            registry.findPlugin( name )->findInfo( name ).quality;
+        const uint32_t* destData = reinterpret_cast< const uint32_t* >(
+            destImage.getPixelPointer( buffer ));
+
+        if( name == EQ_COMPRESSOR_DEPTH_PREDICT_LOSSY )
+            _compareDepth( data, destData, 2048 );
+        else if( quality >= 1.f )
+            _compareDepth( data, destData, 0 );
+        else
+            _compare< uint32_t >( data.data(), destData, buffer, true,
+                                  data.size(), quality );
+
+        const float mBytes = float( size ) / 1024.f / 1024.f;
+        std::cout << "0x" << std::setw(8) << std::setfill( '0' )
+                  << std::hex << name << std::dec << std::setfill(' ')
+                  << ", " << std::setw(8) << coverage << ", "
+                  << std::setw(10) << size << ", " << std::setw(10)
+                  << compressedSize << ", " << std::setw(6)
+                  << float( compressedSize ) / float( size ) << ", "
+                  << std::setw(11) << mBytes * 1000.f / compressTime
+                  << ", " << std::setw(11)
+                  << mBytes * 1000.f / decompressTime << std::endl;
+    }
+    image.flush();
+    destImage.flush();
+}
+
+// Tests the depth compressors on DB depth buffers with varying coverage
+void _testDepth( const std::vector< uint32_t >& names )
+{
+    static const float radii[] = { 0.f, .1f, .3f, 1.f };
+
+    std::cout << "COMPRESSOR, COVERAGE,       SIZE, COMPRESSED,  RATIO,"
+              << "   MB/s_comp, MB/s_decomp" << std::endl;
+
+    const eq::PixelViewport pvp( 0, 0, 1920, 1080 );
+    for( const float radius : radii )
+        _testDepth( names, pvp, _createDepth( pvp.w, pvp.h, radius ));
+
+    // a last, partial block of 59 pixels with mixed coverage
+    const eq::PixelViewport partialPVP( 0, 0, 1001, 3 );
+    std::vector< uint32_t > partial = _createDepth( partialPVP.w,
+                                                    partialPVP.h, 1.f );
+    for( size_t i = partial.size() - 59; i < partial.size(); i += 2 )
+        partial[i] = 0x90000000u + uint32_t( i ) * 7u;
+    partial.back() = 0x12345678u;
+    _testDepth( names, partialPVP, partial );
+
+    std::cout << std::endl;
+}
+
+// Tests that a lowered quality of read back pixels selects a lossy compressor
+void _testQuality( const std::string& filename )
+{
+    const auto& registry = pression::PluginRegistry::getInstance();
+    const eq::Frame::Buffer buffer = eq::Frame::Buffer::color;
+    eq::Image image;
+    TEST( image.readImage( filename, buffer ));
+    image.useCompressor( buffer, EQ_COMPRESSOR_AUTO );
+
+    const eq::PixelData& lossless = image.compressPixelData( buffer );
+    const uint32_t losslessName = lossless.compressedData.compressor;
+    const uint64_t losslessSize = lossless.compressedData.getSize();
+    TEST( registry.findPlugin( losslessName )->findInfo( losslessName ).quality
+          == 1.f );
+
+    image.setQuality( buffer, .5f );
+    const eq::PixelData& lossy = image.compressPixelData( buffer );
+    const uint32_t lossyName = lossy.compressedData.compressor;
+    const float quality =
+        registry.findPlugin( lossyName )->findInfo( lossyName ).quality;
+    TESTINFO( quality < 1.f && quality >= .5f,
+              "0x" << std::hex << lossyName << std::dec << ": " << quality );
+    TESTINFO( lossy.compressedData.getSize() < losslessSize,
+              lossy.compressedData.getSize() << " >= " << losslessSize );
+
+    image.setQuality( buffer, 1.f );
+    TEST( image.compressPixelData( buffer ).compressedData.compressor ==
+          losslessName );
+    image.flush();
+}
 }
 
 int main( int argc, char **argv )
@@ -300,9 +476,17 @@ int main( int argc, char **argv )
                                               quality );
                         break;
                     case 4:
-                        _compare< float >( data, destData, buffer,
-                                           image.getAlphaUsage(), nElem,
-                                           quality );
+                        if( image.getExternalFormat( buffer ) ==
+                            EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT )
+                        {
+                            _compare< uint32_t >( data, destData, buffer,
+                                                  image.getAlphaUsage(), nElem,
+                                                  quality );
+                        }
+                        else
+                            _compare< float >( data, destData, buffer,
+                                               image.getAlphaUsage(), nElem,
+                                               quality );
                         break;
                     default:
                         break;
@@ -328,6 +512,17 @@ int main( int argc, char **argv )
         }
     }
 
+    _testDepth( names );
+
+    for( const std::string& filename : images )
+    {
+        if( filename.find( "depth" ) == std::string::npos )
+        {
+            _testQuality( filename );
+            break;
+        }
+    }
+
     image.flush();
     destImage.flush();
     eq::exit();
@@ -0,0 +1,534 @@
+
+/* Copyright (c) 2017, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+//#define BENCHMARK_ALL // all resolutions and thread counts, runs for hours
+
+#ifdef BENCHMARK_ALL
+#  define TEST_RUNTIME 7200 // seconds
+#else
+#  define TEST_RUNTIME 600 // seconds
+#endif
+#include <lunchbox/test.h>
+
+#include <eq/image.h>
+#include <eq/init.h>
+#include <eq/nodeFactory.h>
+#include <eq/pixelData.h>
+
+#include <lunchbox/clock.h>
+#include <pression/plugins/compressor.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef _OPENMP
+#  include <omp.h>
+#endif
+
+// Benchmarks all CPU compressors on synthetic images resembling rendered
+// content: DB color and depth pairs, mostly empty region of interest images,
+// noisy volume slices and HDR buffers. By default, only 1920x1080 images are
+// run single-threaded and on all processors. Define BENCHMARK_ALL for all
+// resolutions and thread counts. The compressor 'auto' uses the automatic
+// plugin selection of the image, reported in the 'plugin' column.
+//
+// The error is the mean absolute difference of all channels, relative to the
+// channel range for integer formats and to the mean magnitude for floats.
+//
+// Usage: compressorBenchmark [csv|json] [iterations]
+
+namespace
+{
+struct Resolution
+{
+    int32_t w;
+    int32_t h;
+};
+
+#ifdef BENCHMARK_ALL
+static const Resolution RESOLUTIONS[] = {{ 640, 480 }, { 1920, 1080 },
+                                         { 3840, 2160 }};
+#else
+static const Resolution RESOLUTIONS[] = {{ 1920, 1080 }};
+#endif
+
+/** One synthetic image buffer. */
+struct Content
+{
+    std::string name;
+    eq::Frame::Buffer buffer;
+    uint32_t internalFormat;
+    uint32_t externalFormat;
+    uint32_t pixelSize;
+    std::vector< uint8_t > pixels;
+};
+
+/** One benchmark result. */
+struct Result
+{
+    std::string compressor;
+    uint32_t plugin;
+    std::string image;
+    eq::PixelViewport pvp;
+    int threads;
+    bool alpha;
+    uint64_t size;
+    uint64_t compressedSize;
+    float compressTime;
+    float decompressTime;
+    double error;
+};
+
+// deterministic noise in [0,1)
+class Noise
+{
+public:
+    Noise() : _state( 0x12345678u ) {}
+    float operator()()
+    {
+        _state = _state * 1664525u + 1013904223u;
+        return float( _state >> 8 ) / float( 1 << 24 );
+    }
+private:
+    uint32_t _state;
+};
+
+uint16_t _floatToHalf( const float value )
+{
+    uint32_t bits;
+    ::memcpy( &bits, &value, sizeof( bits ));
+    const uint16_t sign = uint16_t(( bits >> 16 ) & 0x8000u );
+    const int32_t exponent = int32_t(( bits >> 23 ) & 0xff ) - 127 + 15;
+    if( exponent <= 0 )
+        return sign; // flush small values to zero
+    if( exponent >= 31 )
+        return sign | 0x7bff; // clamp to the largest half
+    return sign | uint16_t( exponent << 10 ) |
+           uint16_t(( bits >> 13 ) & 0x3ff );
+}
+
+float _halfToFloat( const uint16_t value )
+{
+    const uint32_t exponent = ( value >> 10 ) & 0x1f;
+    const float mantissa = float( value & 0x3ff ) / 1024.f;
+    const float sign = ( value & 0x8000 ) ? -1.f : 1.f;
+    if( exponent == 0 )
+        return sign * std::ldexp( mantissa, -14 );
+    return sign * std::ldexp( 1.f + mantissa, int( exponent ) - 15 );
+}
+
+Content _newContent( const std::string& name, const eq::PixelViewport& pvp,
+                     const eq::Frame::Buffer buffer, const uint32_t format,
+                     const uint32_t pixelSize )
+{
+    Content content;
+    content.name = name;
+    content.buffer = buffer;
+    content.internalFormat = format;
+    content.externalFormat = format;
+    content.pixelSize = pixelSize;
+    content.pixels.resize( size_t( pvp.getArea( )) * pixelSize );
+    return content;
+}
+
+// Shaded spheres on an empty background, as read back from one DB source
+void _createDB( const eq::PixelViewport& pvp, std::vector< Content >& contents )
+{
+    Content color = _newContent( "db_color", pvp, eq::Frame::Buffer::color,
+                                 EQ_COMPRESSOR_DATATYPE_RGBA, 4 );
+    Content depth = _newContent( "db_depth", pvp, eq::Frame::Buffer::depth,
+                                 EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT, 4 );
+    depth.internalFormat = EQ_COMPRESSOR_DATATYPE_DEPTH;
+
+    static const float spheres[][3] = {{ .3f, .4f, .15f }, { .6f, .55f, .2f },
+                                       { .45f, .75f, .1f }};
+    uint8_t* colors = color.pixels.data();
+    uint32_t* depths = reinterpret_cast< uint32_t* >( depth.pixels.data( ));
+    const float scale = float( pvp.h );
+
+    for( int32_t y = 0; y < pvp.h; ++y )
+    {
+        for( int32_t x = 0; x < pvp.w; ++x, colors += 4, ++depths )
+        {
+            *depths = 0xffffffffu;
+            colors[0] = colors[1] = colors[2] = colors[3] = 0;
+
+            for( size_t i = 0; i < 3; ++i )
+            {
+                const float dx = float( x ) / scale - spheres[i][0] *
+                                 float( pvp.w ) / scale;
+                const float dy = float( y ) / scale - spheres[i][1];
+                const float r2 = spheres[i][2] * spheres[i][2];
+                const float d2 = dx * dx + dy * dy;
+                if( d2 >= r2 )
+                    continue;
+
+                const float z = std::sqrt( r2 - d2 ) / spheres[i][2];
+                const uint32_t value = uint32_t(( .5f - .1f * float( i ) -
+                                                  .05f * z ) * 4294967295.f );
+                if( value >= *depths )
+                    continue;
+
+                *depths = value;
+                const float shade = .2f + .8f * z;
+                colors[0] = uint8_t( shade * ( i == 0 ? 255.f : 128.f ));
+                colors[1] = uint8_t( shade * ( i == 1 ? 255.f : 128.f ));
+                colors[2] = uint8_t( shade * ( i == 2 ? 255.f : 128.f ));
+                colors[3] = 255;
+            }
+        }
+    }
+    contents.push_back( color );
+    contents.push_back( depth );
+}
+
+// A small rendered region in an otherwise cleared image
+void _createROI( const eq::PixelViewport& pvp, std::vector< Content >& contents)
+{
+    Content roi = _newContent( "roi", pvp, eq::Frame::Buffer::color,
+                               EQ_COMPRESSOR_DATATYPE_RGBA, 4 );
+    const int32_t x0 = pvp.w / 3;
+    const int32_t y0 = pvp.h / 3;
+    const int32_t x1 = x0 + pvp.w / 5;
+    const int32_t y1 = y0 + pvp.h / 4;
+
+    for( int32_t y = y0; y < y1; ++y )
+    {
+        uint8_t* pixel = roi.pixels.data() + ( size_t( y ) * pvp.w + x0 ) * 4;
+        for( int32_t x = x0; x < x1; ++x, pixel += 4 )
+        {
+            pixel[0] = uint8_t( x - x0 );
+            pixel[1] = uint8_t( y - y0 );
+            pixel[2] = uint8_t(( x ^ y ) & 0xf0 );
+            pixel[3] = 255;
+        }
+    }
+    contents.push_back( roi );
+}
+
+// Premultiplied, semi-transparent slice of a noisy volume
+void _createVolume( const eq::PixelViewport& pvp,
+                    std::vector< Content >& contents )
+{
+    Content volume = _newContent( "volume", pvp, eq::Frame::Buffer::color,
+                                  EQ_COMPRESSOR_DATATYPE_RGBA, 4 );
+    Noise noise;
+    uint8_t* pixel = volume.pixels.data();
+    for( int32_t y = 0; y < pvp.h; ++y )
+    {
+        for( int32_t x = 0; x < pvp.w; ++x, pixel += 4 )
+        {
+            const float u = float( x ) / float( pvp.w );
+            const float v = float( y ) / float( pvp.h );
+            const float density = .5f + .25f * ( noise() - .5f ) +
+                             .25f * std::sin( u * 17.f ) * std::cos( v * 11.f );
+            const float alpha = std::min( std::max( density, 0.f ), 1.f );
+            pixel[0] = uint8_t( 255.f * alpha * u );
+            pixel[1] = uint8_t( 255.f * alpha * ( 1.f - u ));
+            pixel[2] = uint8_t( 255.f * alpha * v );
+            pixel[3] = uint8_t( 255.f * alpha );
+        }
+    }
+    contents.push_back( volume );
+}
+
+// Smooth radiance with a few bright highlights, as half and single floats
+void _createHDR( const eq::PixelViewport& pvp,
+                 std::vector< Content >& contents )
+{
+    Content half = _newContent( "hdr_half", pvp, eq::Frame::Buffer::color,
+                                EQ_COMPRESSOR_DATATYPE_RGBA16F, 8 );
+    Content single = _newContent( "hdr_float", pvp, eq::Frame::Buffer::color,
+                                  EQ_COMPRESSOR_DATATYPE_RGBA32F, 16 );
+    uint16_t* halfs = reinterpret_cast< uint16_t* >( half.pixels.data( ));
+    float* floats = reinterpret_cast< float* >( single.pixels.data( ));
+
+    for( int32_t y = 0; y < pvp.h; ++y )
+    {
+        for( int32_t x = 0; x < pvp.w; ++x, halfs += 4, floats += 4 )
+        {
+            const float u = float( x ) / float( pvp.w );
+            const float v = float( y ) / float( pvp.h );
+            const float dx = u - .7f;
+            const float dy = v - .3f;
+            const float highlight = 100.f * std::exp( -400.f * ( dx * dx +
+                                                                 dy * dy ));
+            floats[0] = .1f + u + highlight;
+            floats[1] = .1f + v + highlight;
+            floats[2] = .1f + u * v + .5f * highlight;
+            floats[3] = 1.f;
+            for( size_t c = 0; c < 4; ++c )
+                halfs[c] = _floatToHalf( floats[c] );
+        }
+    }
+    contents.push_back( half );
+    contents.push_back( single );
+}
+
+double _getError( const Content& content, const uint8_t* result,
+                  const bool alpha )
+{
+    const size_t nChannels = content.externalFormat ==
+        EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT ? 1 : 4;
+    const size_t nValues = content.pixels.size() / content.pixelSize *
+                           nChannels;
+    double error = 0.;
+    double magnitude = 0.;
+
+    for( size_t i = 0; i < nValues; ++i )
+    {
+        if( !alpha && nChannels == 4 && i % 4 == 3 )
+            continue; // alpha is undefined if ignored
+
+        double value = 0.;
+        double other = 0.;
+        switch( content.externalFormat )
+        {
+        case EQ_COMPRESSOR_DATATYPE_RGBA:
+            value = content.pixels[i] / 255.;
+            other = result[i] / 255.;
+            break;
+        case EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT:
+        {
+            uint32_t a, b;
+            ::memcpy( &a, content.pixels.data() + i * 4, 4 );
+            ::memcpy( &b, result + i * 4, 4 );
+            value = a / 4294967295.;
+            other = b / 4294967295.;
+            break;
+        }
+        case EQ_COMPRESSOR_DATATYPE_RGBA16F:
+        {
+            uint16_t a, b;
+            ::memcpy( &a, content.pixels.data() + i * 2, 2 );
+            ::memcpy( &b, result + i * 2, 2 );
+            value = _halfToFloat( a );
+            other = _halfToFloat( b );
+            magnitude += std::fabs( value );
+            break;
+        }
+        case EQ_COMPRESSOR_DATATYPE_RGBA32F:
+        {
+            float a, b;
+            ::memcpy( &a, content.pixels.data() + i * 4, 4 );
+            ::memcpy( &b, result + i * 4, 4 );
+            value = a;
+            other = b;
+            magnitude += std::fabs( value );
+            break;
+        }
+        }
+        error += std::fabs( value - other );
+    }
+
+    if( magnitude > 0. )
+        return error / magnitude;
+    return error / double( nValues );
+}
+
+Result _run( eq::Image& image, eq::Image& destImage, const Content& content,
+             const uint32_t name, const int nThreads,
+             const size_t iterations )
+{
+#ifdef _OPENMP
+    omp_set_num_threads( nThreads );
+#endif
+
+    const eq::Frame::Buffer buffer = content.buffer;
+    const eq::PixelViewport& pvp = image.getPixelViewport();
+    lunchbox::Clock clock;
+
+    Result result;
+    result.compressor = "auto";
+    if( name != EQ_COMPRESSOR_AUTO )
+    {
+        std::ostringstream os;
+        os << "0x" << std::hex << name;
+        result.compressor = os.str();
+        TEST( image.allocCompressor( buffer, name ));
+    }
+    image.useCompressor( buffer, name );
+
+    result.image = content.name;
+    result.pvp = pvp;
+    result.alpha = image.getAlphaUsage();
+    result.size = content.pixels.size();
+    result.compressedSize = 0;
+    result.compressTime = 0.f;
+    result.decompressTime = 0.f;
+    result.plugin = EQ_COMPRESSOR_NONE;
+    result.threads = nThreads;
+
+    for( size_t i = 0; i < iterations; ++i )
+    {
+        image.invalidateCompressedData( buffer );
+
+        clock.reset();
+        const eq::PixelData& pixels = image.compressPixelData( buffer );
+        result.compressTime += clock.getTimef();
+
+        clock.reset();
+        destImage.setPixelViewport( pvp );
+        destImage.setPixelData( buffer, pixels );
+        result.decompressTime += clock.getTimef();
+
+        result.plugin = pixels.compressedData.compressor;
+        result.compressedSize = pixels.compressedData.isCompressed() ?
+                                pixels.compressedData.getSize() : result.size;
+    }
+
+    result.compressTime /= float( iterations );
+    result.decompressTime /= float( iterations );
+    result.error = _getError( content, destImage.getPixelPointer( buffer ),
+                              result.alpha );
+    return result;
+}
+
+float _getMBs( const uint64_t size, const float time )
+{
+    return time > 0.f ? float( size ) / 1048.576f / time : 0.f;
+}
+
+void _write( std::ostream& os, const Result& result, const bool json,
+             const bool first )
+{
+    const float ratio = float( result.compressedSize ) / float( result.size );
+    if( json )
+    {
+        os << ( first ? "  {" : ",\n  {" )
+           << " \"compressor\": \"" << result.compressor << "\","
+           << " \"plugin\": " << result.plugin << ","
+           << " \"image\": \"" << result.image << "\","
+           << " \"width\": " << result.pvp.w << ","
+           << " \"height\": " << result.pvp.h << ","
+           << " \"threads\": " << result.threads << ","
+           << " \"alpha\": " << ( result.alpha ? "true" : "false" ) << ","
+           << " \"size\": " << result.size << ","
+           << " \"compressed\": " << result.compressedSize << ","
+           << " \"ratio\": " << ratio << ","
+           << " \"compress_MBps\": "
+           << _getMBs( result.size, result.compressTime ) << ","
+           << " \"decompress_MBps\": "
+           << _getMBs( result.size, result.decompressTime ) << ","
+           << " \"error\": " << result.error << " }";
+        return;
+    }
+
+    os << result.compressor << ",0x" << std::hex << result.plugin << std::dec
+       << "," << result.image << "," << result.pvp.w << "," << result.pvp.h
+       << "," << result.threads << "," << result.alpha << "," << result.size
+       << "," << result.compressedSize << "," << ratio << ","
+       << _getMBs( result.size, result.compressTime ) << ","
+       << _getMBs( result.size, result.decompressTime ) << ","
+       << result.error << std::endl;
+}
+}
+
+int main( int argc, char **argv )
+{
+    eq::NodeFactory nodeFactory;
+    TEST( eq::init( argc, argv, &nodeFactory ));
+
+    const bool json = argc > 1 && std::string( argv[1] ) == "json";
+    const size_t iterations = argc > 2 ?
+        std::max( ::atoi( argv[2] ), 1 ) : 3;
+
+    std::vector< int > threads( 1, 1 );
+#ifdef _OPENMP
+    const int nProcs = omp_get_num_procs();
+#  ifdef BENCHMARK_ALL
+    for( int i = 2; i < nProcs; i *= 2 )
+        threads.push_back( i );
+#  endif
+    if( nProcs > 1 )
+        threads.push_back( nProcs );
+#endif
+
+    std::cout.precision( 5 );
+    if( json )
+        std::cout << "[" << std::endl;
+    else
+        std::cout << "compressor,plugin,image,width,height,threads,alpha,size,"
+                  << "compressed,ratio,compress_MBps,decompress_MBps,error"
+                  << std::endl;
+
+    bool first = true;
+    for( const Resolution& resolution : RESOLUTIONS )
+    {
+        const eq::PixelViewport pvp( 0, 0, resolution.w, resolution.h );
+        std::vector< Content > contents;
+        _createDB( pvp, contents );
+        _createROI( pvp, contents );
+        _createVolume( pvp, contents );
+        _createHDR( pvp, contents );
+
+        for( const Content& content : contents )
+        {
+            eq::PixelData pixels;
+            pixels.internalFormat = content.internalFormat;
+            pixels.externalFormat = content.externalFormat;
+            pixels.pixelSize = content.pixelSize;
+            pixels.pvp = pvp;
+            pixels.pixels = const_cast< uint8_t* >( content.pixels.data( ));
+
+            eq::Image image;
+            eq::Image destImage;
+            image.setPixelViewport( pvp );
+            image.setPixelData( content.buffer, pixels );
+
+            std::vector< uint32_t > names =
+                image.findCompressors( content.buffer );
+            names.push_back( EQ_COMPRESSOR_AUTO );
+
+            const bool hasAlpha = content.buffer == eq::Frame::Buffer::color &&
+                                  image.hasAlpha();
+            for( const bool alpha : { true, false })
+            {
+                if( !alpha && !hasAlpha )
+                    continue; // ignoring alpha doesn't make sense
+                image.setAlphaUsage( alpha );
+                destImage.setAlphaUsage( alpha );
+
+                for( const uint32_t name : names )
+                {
+                    for( const int nThreads : threads )
+                    {
+                        const Result result = _run( image, destImage, content,
+                                                    name, nThreads,
+                                                    iterations );
+                        _write( std::cout, result, json, first );
+                        first = false;
+                    }
+                }
+            }
+            image.flush();
+            destImage.flush();
+        }
+    }
+
+    if( json )
+        std::cout << std::endl << "]" << std::endl;
+
+    eq::exit();
+    return EXIT_SUCCESS;
+}
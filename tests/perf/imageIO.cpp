@@ -0,0 +1,257 @@
+
+/* Copyright (c) 2016, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#define TEST_RUNTIME 600 // seconds
+#include <lunchbox/test.h>
+
+#include <eq/image.h>
+#include <eq/init.h>
+#include <eq/nodeFactory.h>
+#include <eq/pixelData.h>
+
+#include <lunchbox/clock.h>
+#include <pression/plugins/compressor.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <limits>
+#include <vector>
+
+// Measures the pixel conversion of Image::writeImage and Image::readImage for
+// the supported color and depth formats, using synthetic full HD images. Also
+// checks the un-premultiplication of BGRA images and the 8 bit s_ preview of
+// half and float images.
+// Usage: imageIO [iterations]
+
+namespace
+{
+static const int32_t WIDTH = 1920;
+static const int32_t HEIGHT = 1080;
+static const char* const FILENAME = "imageIO.rgb";
+static const char* const SMALL_FILENAME = "s_imageIO.rgb";
+
+struct Format
+{
+    const char* name;
+    eq::Frame::Buffer buffer;
+    uint32_t internalFormat;
+    uint32_t externalFormat;
+    uint32_t pixelSize;
+};
+
+static const Format FORMATS[] = {
+    { "RGBA", eq::Frame::Buffer::color, EQ_COMPRESSOR_DATATYPE_RGBA,
+      EQ_COMPRESSOR_DATATYPE_RGBA, 4 },
+    { "RGB", eq::Frame::Buffer::color, EQ_COMPRESSOR_DATATYPE_RGBA,
+      EQ_COMPRESSOR_DATATYPE_RGB, 3 },
+    { "RGBA16F", eq::Frame::Buffer::color, EQ_COMPRESSOR_DATATYPE_RGBA16F,
+      EQ_COMPRESSOR_DATATYPE_RGBA16F, 8 },
+    { "RGBA32F", eq::Frame::Buffer::color, EQ_COMPRESSOR_DATATYPE_RGBA32F,
+      EQ_COMPRESSOR_DATATYPE_RGBA32F, 16 },
+    { "DEPTH", eq::Frame::Buffer::depth, EQ_COMPRESSOR_DATATYPE_DEPTH,
+      EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT, 4 }
+};
+
+// blocky pattern, gives runs for the run-length encoding
+std::vector< uint8_t > _createPixels( const Format& format )
+{
+    std::vector< uint8_t > pixels( size_t( WIDTH ) * HEIGHT *
+                                   format.pixelSize );
+    size_t i = 0;
+    for( int32_t y = 0; y < HEIGHT; ++y )
+        for( int32_t x = 0; x < WIDTH; ++x )
+            for( uint32_t c = 0; c < format.pixelSize; ++c )
+                pixels[ i++ ] = uint8_t( x / 16 + y / 16 + c * 64 );
+    return pixels;
+}
+
+eq::PixelData _createPixelData( const uint32_t internalFormat,
+                                const uint32_t externalFormat,
+                                const uint32_t pixelSize,
+                                const eq::PixelViewport& pvp, void* data )
+{
+    eq::PixelData pixels;
+    pixels.internalFormat = internalFormat;
+    pixels.externalFormat = externalFormat;
+    pixels.pixelSize = pixelSize;
+    pixels.pvp = pvp;
+    pixels.pixels = data;
+    return pixels;
+}
+
+// premultiplied BGRA, as read back with alpha, is written un-premultiplied
+void _testUnpremultiply()
+{
+    const eq::PixelViewport pvp( 0, 0, 256, 256 );
+    std::vector< uint8_t > data( pvp.getArea() * 4 );
+    std::vector< uint8_t > expected( data.size( ));
+    for( int32_t a = 0; a < pvp.h; ++a )
+        for( int32_t x = 0; x < pvp.w; ++x )
+        {
+            // red values larger than alpha are clamped
+            const uint32_t bgra[4] = { 255u - x, x / 2u, uint32_t( x ),
+                                       uint32_t( a ) };
+            uint8_t* pixel = &data[ ( a * pvp.w + x ) * 4 ];
+            uint8_t* rgba = &expected[ ( a * pvp.w + x ) * 4 ];
+            for( size_t c = 0; c < 4; ++c )
+                pixel[ c ] = uint8_t( bgra[ c ] );
+
+            for( size_t c = 0; c < 3; ++c )
+                rgba[ 2 - c ] = uint8_t( a == 0 ? bgra[ c ] :
+                                 std::min( bgra[ c ] * 255u / a, 255u ));
+            rgba[ 3 ] = uint8_t( a );
+        }
+
+    eq::Image image;
+    image.setPixelViewport( pvp );
+    image.setPixelData( eq::Frame::Buffer::color,
+                        _createPixelData( EQ_COMPRESSOR_DATATYPE_RGBA,
+                                          EQ_COMPRESSOR_DATATYPE_BGRA, 4, pvp,
+                                          data.data( )));
+    image.setPremultipliedAlpha( true );
+
+    eq::Image result;
+    TEST( image.writeImage( FILENAME, eq::Frame::Buffer::color ));
+    TEST( result.readImage( FILENAME, eq::Frame::Buffer::color ));
+    TEST( result.getExternalFormat( eq::Frame::Buffer::color ) ==
+          EQ_COMPRESSOR_DATATYPE_RGBA );
+    TEST( result.getPixelDataSize( eq::Frame::Buffer::color ) ==
+          expected.size( ));
+    TEST( ::memcmp( result.getPixelPointer( eq::Frame::Buffer::color ),
+                    expected.data(), expected.size( )) == 0 );
+}
+
+// half and float images also write an 8 bit s_ preview, clamped to [0, 1]
+void _testPreview()
+{
+    static const size_t nValues = 8;
+    const float values[ nValues ] = {
+        -1.f, 0.f, .25f, .5f, 1.f, 2.f,
+        std::numeric_limits< float >::quiet_NaN(),
+        std::numeric_limits< float >::infinity() };
+    const uint16_t halfs[ nValues ] = { 0xbc00, 0x0000, 0x3400, 0x3800,
+                                        0x3c00, 0x4000, 0x7e00, 0x7c00 };
+    const uint8_t bytes[ nValues ] = { 0, 0, 63, 127, 255, 255, 0, 255 };
+
+    const eq::PixelViewport pvp( 0, 0, 64, 16 );
+    const size_t nComponents = pvp.getArea() * 4;
+    std::vector< float > floatData( nComponents );
+    std::vector< uint16_t > halfData( nComponents );
+    std::vector< uint8_t > expected( nComponents );
+    for( size_t i = 0; i < nComponents; ++i )
+    {
+        const size_t value = ( i / 4 + i % 4 ) % nValues;
+        floatData[ i ] = values[ value ];
+        halfData[ i ] = halfs[ value ];
+        expected[ i ] = bytes[ value ];
+    }
+
+    const eq::PixelData inputs[] = {
+        _createPixelData( EQ_COMPRESSOR_DATATYPE_RGBA32F,
+                          EQ_COMPRESSOR_DATATYPE_RGBA32F, 16, pvp,
+                          floatData.data( )),
+        _createPixelData( EQ_COMPRESSOR_DATATYPE_RGBA16F,
+                          EQ_COMPRESSOR_DATATYPE_RGBA16F, 8, pvp,
+                          halfData.data( )) };
+
+    for( const eq::PixelData& input : inputs )
+    {
+        eq::Image image;
+        image.setPixelViewport( pvp );
+        image.setPixelData( eq::Frame::Buffer::color, input );
+
+        eq::Image result;
+        TEST( image.writeImage( FILENAME, eq::Frame::Buffer::color ));
+        TEST( result.readImage( SMALL_FILENAME, eq::Frame::Buffer::color ));
+        TEST( result.getExternalFormat( eq::Frame::Buffer::color ) ==
+              EQ_COMPRESSOR_DATATYPE_RGBA );
+        TEST( result.getPixelDataSize( eq::Frame::Buffer::color ) ==
+              expected.size( ));
+        TESTINFO( ::memcmp( result.getPixelPointer( eq::Frame::Buffer::color ),
+                            expected.data(), expected.size( )) == 0,
+                  input.pixelSize );
+    }
+}
+}
+
+int main( int argc, char **argv )
+{
+    eq::NodeFactory nodeFactory;
+    TEST( eq::init( argc, argv, &nodeFactory ));
+    const size_t iterations = argc > 1 ? ::atoi( argv[1] ) : 10;
+
+    std::cout.setf( std::ios::right, std::ios::adjustfield );
+    std::cout.precision( 5 );
+    std::cout << " FORMAT,       SIZE,    t_write, t_writeRLE,     t_read"
+              << std::endl;
+
+    lunchbox::Clock clock;
+    for( const Format& format : FORMATS )
+    {
+        std::vector< uint8_t > data = _createPixels( format );
+        const eq::PixelViewport pvp( 0, 0, WIDTH, HEIGHT );
+
+        eq::Image image;
+        image.setPixelViewport( pvp );
+        image.setPixelData( format.buffer,
+                            _createPixelData( format.internalFormat,
+                                              format.externalFormat,
+                                              format.pixelSize, pvp,
+                                              data.data( )));
+
+        float writeTime = 0.f;
+        float rleTime = 0.f;
+        float readTime = 0.f;
+        eq::Image result;
+
+        for( size_t i = 0; i < iterations; ++i )
+        {
+            clock.reset();
+            TEST( image.writeImage( FILENAME, format.buffer, true ));
+            rleTime += clock.getTimef();
+
+            clock.reset();
+            TEST( image.writeImage( FILENAME, format.buffer ));
+            writeTime += clock.getTimef();
+
+            clock.reset();
+            TEST( result.readImage( FILENAME, format.buffer ));
+            readTime += clock.getTimef();
+        }
+
+        TEST( result.getPixelViewport() == pvp );
+        TEST( result.getPixelDataSize( format.buffer ) == data.size( ));
+        TESTINFO( ::memcmp( result.getPixelPointer( format.buffer ),
+                            data.data(), data.size( )) == 0, format.name );
+
+        std::cout << std::setw(7) << format.name << ", " << std::setw(10)
+                  << data.size() << ", " << std::setw(10)
+                  << writeTime / iterations << ", " << std::setw(10)
+                  << rleTime / iterations << ", " << std::setw(10)
+                  << readTime / iterations << std::endl;
+    }
+
+    _testUnpremultiply();
+    _testPreview();
+
+    ::remove( FILENAME );
+    ::remove( SMALL_FILENAME );
+    eq::exit();
+    return EXIT_SUCCESS;
+}
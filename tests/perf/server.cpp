@@ -0,0 +1,136 @@
+/* Copyright (c) 2016, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#define TEST_RUNTIME 1200 // seconds
+#include <lunchbox/test.h>
+
+#include <eq/server/config.h>
+#include <eq/server/configSimulator.h>
+#include <eq/server/global.h>
+#include <eq/server/loader.h>
+#include <eq/server/server.h>
+
+#include <lunchbox/init.h>
+
+#include <cstdlib>
+#include <iomanip>
+#include <sstream>
+
+// Measures the server-side frame overhead of growing load-balanced configs,
+// using stub render clients with synthetic statistics. Usage: server [nodes]
+
+namespace
+{
+static const size_t PIPES = 2; // per node
+static const size_t WARMUP = 5;
+static const size_t FRAMES = 20;
+
+// nNodes x PIPES windows, all contributing to the first channel
+std::string _createConfig( const size_t nNodes, const std::string& mode )
+{
+    std::ostringstream os;
+    os << "#Equalizer 1.2 ascii\nserver\n{\n  config\n  {\n";
+    for( size_t i = 0; i < nNodes; ++i )
+    {
+        os << ( i == 0 ? "    appNode\n    {\n" : "    node\n    {\n" );
+        for( size_t j = 0; j < PIPES; ++j )
+            os << "      pipe { window { viewport [ 0 0 640 480 ] "
+               << "channel { name \"channel" << i * PIPES + j << "\" }}}\n";
+        os << "    }\n";
+    }
+
+    os << "    compound\n    {\n"
+       << "      channel \"channel0\"\n"
+       << "      load_equalizer { mode " << mode << " }\n"
+       << "      wall { bottom_left  [ -.32 -.20 -.75 ]\n"
+       << "             bottom_right [  .32 -.20 -.75 ]\n"
+       << "             top_left     [ -.32  .20 -.75 ] }\n"
+       << "      compound {}\n";
+    for( size_t i = 1; i < nNodes * PIPES; ++i )
+        os << "      compound { channel \"channel" << i
+           << "\" outputframe {} }\n";
+    for( size_t i = 1; i < nNodes * PIPES; ++i )
+        os << "      inputframe { name \"frame.channel" << i << "\" }\n";
+    os << "    }\n  }\n}\n";
+    return os.str();
+}
+}
+
+int main( int argc, char **argv )
+{
+    TEST( lunchbox::init( argc, argv ));
+
+    const size_t maxNodes = argc > 1 ? ::atoi( argv[1] ) : 4096;
+    eq::server::Loader loader;
+
+    std::cout.setf( std::ios::right, std::ios::adjustfield );
+    std::cout.precision( 5 );
+    std::cout << "MODE,  NODES, CHANNELS, t_equalizer,   t_update,     t_task,"
+              << "      TASKS,      BYTES" << std::endl;
+
+    const std::string modes[] = { "2D", "DB" };
+    for( const std::string& mode : modes )
+    {
+        for( size_t nNodes = 1; nNodes <= maxNodes; nNodes <<= 1 )
+        {
+            const std::string config = _createConfig( nNodes, mode );
+            eq::server::ServerPtr server =
+                loader.parseServer( config.c_str( ));
+            TESTINFO( server.isValid(), config );
+            TEST( server->getConfigs().size() == 1 );
+
+            eq::server::ConfigSimulator::Stats total;
+            {
+                eq::server::Config* serverConfig = server->getConfigs()[0];
+                eq::server::ConfigSimulator simulator( *serverConfig );
+
+                // heterogeneous nodes give the load equalizer some work
+                const eq::server::Nodes& nodes = serverConfig->getNodes();
+                for( size_t i = 0; i < nodes.size(); ++i )
+                    simulator.setSpeed( nodes[i], 1.f + float( i % 3 ) * .5f );
+
+                for( size_t i = 0; i < WARMUP; ++i )
+                    simulator.frame();
+
+                for( size_t i = 0; i < FRAMES; ++i )
+                {
+                    const eq::server::ConfigSimulator::Stats& stats =
+                        simulator.frame();
+                    TESTINFO( stats.nTasks > 0, simulator.getFrameNumber( ));
+
+                    total.equalizerTime += stats.equalizerTime;
+                    total.updateTime += stats.updateTime;
+                    total.taskTime += stats.taskTime;
+                    total.nTasks += stats.nTasks;
+                    total.nBytes += stats.nBytes;
+                }
+            }
+
+            std::cout << std::setw(4) << mode << ", " << std::setw(6)
+                      << nNodes << ", " << std::setw(8) << nNodes * PIPES
+                      << ", " << std::setw(11) << total.equalizerTime / FRAMES
+                      << ", " << std::setw(10) << total.updateTime / FRAMES
+                      << ", " << std::setw(10) << total.taskTime / FRAMES
+                      << ", " << std::setw(10)
+                      << total.nTasks / FRAMES << ", " << std::setw(10)
+                      << total.nBytes / FRAMES << std::endl;
+
+            eq::server::Global::clear();
+            server->deleteConfigs(); // break server <-> config ref circle
+        }
+    }
+    return EXIT_SUCCESS;
+}
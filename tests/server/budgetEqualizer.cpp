@@ -0,0 +1,133 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Tests the budget equalizer on a channel used by two compounds, driven by the
+// stub render clients of the config simulator
+
+#include <lunchbox/test.h>
+
+#include <eq/server/compound.h>
+#include <eq/server/config.h>
+#include <eq/server/configSimulator.h>
+#include <eq/server/global.h>
+#include <eq/server/loader.h>
+#include <eq/server/server.h>
+#include <eq/fabric/pixelViewport.h>
+#include <eq/fabric/zoom.h>
+
+#include <lunchbox/init.h>
+
+#include <cmath>
+#include <limits>
+#include <sstream>
+
+using namespace eq::server;
+
+namespace
+{
+static const size_t FRAMES = 50;
+
+// simulated draw time of one pixel, see ConfigSimulator
+static const float DRAW_TIME = 0.0001f;
+
+// both halves of the destination are rendered on the "buffer" channel
+std::string _createConfig( const float frameRate )
+{
+    std::ostringstream os;
+    os << "#Equalizer 1.2 ascii\nserver\n{\n  config\n  {\n"
+       << "    appNode\n    {\n      pipe\n      {\n"
+       << "        window { viewport [ 0 0 640 480 ]"
+       << " channel { name \"channel\" }}\n"
+       << "        window { viewport [ 0 0 640 480 ]"
+       << " channel { name \"buffer\" }}\n"
+       << "      }\n    }\n"
+       << "    compound\n    {\n"
+       << "      channel \"channel\"\n"
+       << "      budget_equalizer { framerate " << frameRate << " }\n"
+       << "      wall { bottom_left  [ -.32 -.20 -.75 ]\n"
+       << "             bottom_right [  .32 -.20 -.75 ]\n"
+       << "             top_left     [ -.32  .20 -.75 ] }\n"
+       << "      compound { channel \"buffer\" viewport [ 0 0 .5 1 ]\n"
+       << "                 outputframe { name \"left\" }}\n"
+       << "      compound { channel \"buffer\" viewport [ .5 0 .5 1 ]\n"
+       << "                 outputframe { name \"right\" }}\n"
+       << "      inputframe { name \"left\" }\n"
+       << "      inputframe { name \"right\" }\n"
+       << "    }\n  }\n}\n";
+    return os.str();
+}
+
+struct Result
+{
+    Zoom zoom; //!< Zoom of the rendering children
+    float time; //!< Simulated frame time of the buffer channel, in ms
+    float maxFPS; //!< Throttled frame rate of the compound
+};
+
+Result _run( const float frameRate )
+{
+    Loader loader;
+    const std::string config = _createConfig( frameRate );
+    ServerPtr server = loader.parseServer( config.c_str( ));
+    TESTINFO( server.isValid(), config );
+    TEST( server->getConfigs().size() == 1 );
+
+    Result result;
+    {
+        Config* serverConfig = server->getConfigs()[0];
+        ConfigSimulator simulator( *serverConfig );
+        for( size_t i = 0; i < FRAMES; ++i )
+            simulator.frame();
+
+        const Compound* root = serverConfig->getCompounds().front();
+        const Compounds& children = root->getChildren();
+        TEST( children.size() == 2 );
+        result.zoom = children.front()->getZoom();
+        TESTINFO( children.back()->getZoom() == result.zoom,
+                  children.back()->getZoom() << " != " << result.zoom );
+
+        // the channel draws both halves from the same start time
+        const PixelViewport& pvp = children.front()->getInheritPixelViewport();
+        result.time = float( pvp.getArea( )) * DRAW_TIME;
+        result.maxFPS = root->getMaxFPS();
+    }
+
+    Global::clear();
+    server->deleteConfigs(); // break server <-> config ref circle
+    return result;
+}
+}
+
+int main( int argc, char **argv )
+{
+    TEST( lunchbox::init( argc, argv ));
+    const float unlimited = std::numeric_limits< float >::max();
+
+    // a half of 640x480 takes 15.4 ms: drop the resolution to fit 10 ms
+    Result result = _run( 100.f );
+    TESTINFO( result.zoom.x() < 1.f && result.zoom.x() > .5f, result.zoom );
+    TESTINFO( std::abs( result.time - 10.f ) < 1.f,
+              result.time << " ms at zoom " << result.zoom );
+    TESTINFO( result.maxFPS == unlimited, result.maxFPS );
+
+    // within 33 ms: keep the full resolution and throttle to the frame rate
+    result = _run( 30.f );
+    TESTINFO( result.zoom == Zoom::NONE, result.zoom );
+    TESTINFO( std::abs( result.time - 15.36f ) < .1f, result.time );
+    TESTINFO( result.maxFPS == 30.f, result.maxFPS );
+
+    return EXIT_SUCCESS;
+}
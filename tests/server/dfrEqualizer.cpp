@@ -0,0 +1,87 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Tests the cost model of the predictive DFR equalizer
+
+#include <lunchbox/test.h>
+#include <eq/server/equalizers/dfrEqualizer.h>
+#include <eq/fabric/pixelViewport.h>
+#include <eq/fabric/zoom.h>
+
+#include <cmath>
+
+using namespace eq::server;
+
+namespace
+{
+const float fullPixels = 1920.f * 1080.f;
+
+// time = 2 ms + 10 ms per megapixel
+float _time( const float pixels ) { return 2.f + pixels * 1e-5f; }
+
+float _predict( const DFREqualizer::Samples& samples, const float frameRate )
+{
+    return DFREqualizer::predictZoom( samples, fullPixels,
+                                      1000.f / frameRate, .5f );
+}
+}
+
+int main( int, char** )
+{
+    DFREqualizer::Samples samples;
+    for( float zoom = 1.f; zoom > .4f; zoom -= .1f )
+    {
+        const float pixels = zoom * zoom * fullPixels;
+        samples.push_front( DFREqualizer::Sample( pixels, _time( pixels )));
+    }
+
+    // the predicted zoom renders within the frame time of the target rate
+    const float rates[] = { 60.f, 90.f, 120.f };
+    for( const float rate : rates )
+    {
+        const float zoom = _predict( samples, rate );
+        const float time = _time( zoom * zoom * fullPixels );
+        TESTINFO( zoom > 0.f && zoom < 1.f, rate << ": " << zoom );
+        TESTINFO( std::abs( time - 1000.f / rate ) < .01f,
+                  rate << " Hz: " << time << " ms at zoom " << zoom );
+    }
+    TEST( _predict( samples, 60.f ) > _predict( samples, 120.f ));
+
+    // the base cost alone misses the target
+    TEST( _predict( samples, 1000.f ) == 0.f );
+
+    // without pixel variance the cost is assumed proportional to the pixels
+    DFREqualizer::Samples constant( 3, DFREqualizer::Sample( fullPixels,
+                                                             20.f ));
+    TESTINFO( std::abs( _predict( constant, 100.f ) - std::sqrt( .5f )) <
+              .0001f, _predict( constant, 100.f ));
+
+    // no samples, no prediction
+    TEST( _predict( DFREqualizer::Samples(), 60.f ) == .5f );
+
+    // zoom is clipped to 128 pixels and to the channel size
+    const PixelViewport pvp( 0, 0, 1024, 512 );
+    const PixelViewport channelPVP( 0, 0, 2048, 2048 );
+    Zoom zoom = DFREqualizer::clipZoom( Zoom( .1f, .1f ), pvp,
+                                            channelPVP );
+    TESTINFO( zoom == Zoom( .25f, .25f ), zoom );
+    zoom = DFREqualizer::clipZoom( Zoom( 3.f, 3.f ), pvp, channelPVP );
+    TESTINFO( zoom == Zoom( 2.f, 2.f ), zoom );
+    zoom = DFREqualizer::clipZoom( Zoom( .5f, .7f ), pvp, channelPVP );
+    TESTINFO( zoom == Zoom( .5f, .5f ), zoom );
+
+    return EXIT_SUCCESS;
+}